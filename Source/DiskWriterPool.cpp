@@ -0,0 +1,62 @@
+/*
+  ==============================================================================
+
+    DiskWriterPool.cpp
+    Created: 19 Oct 2026
+    Author:  Patrick Gammack
+
+  ==============================================================================
+*/
+
+#include "DiskWriterPool.h"
+
+//==============================================================================
+DiskWriterPool::DiskWriterPool()
+{
+}
+
+DiskWriterPool::~DiskWriterPool()
+{
+    // every ThreadedWriter should have been deleted by its instance by now
+    for (auto* thread : threads)
+        jassert (thread->getNumClients() == 0);
+
+    threads.clear();
+}
+
+juce::AudioFormatWriter::ThreadedWriter* DiskWriterPool::createWriter (juce::AudioFormatWriter* writer)
+{
+    const juce::ScopedLock sl (lock);
+    auto& thread = getLeastBusyThread();
+
+    // Size for a full thread even if this writer is alone for now, as others may join it.
+    // Once every thread is full, later writers get proportionally more.
+    const int iSharers = juce::jmax (iWritersPerThread, thread.getNumClients() + 1);
+    const int iNumSamples = juce::jmax (32768, juce::roundToInt (writer->getSampleRate() * (1.0 + dSecondsPerWriter * iSharers)));
+
+    return new juce::AudioFormatWriter::ThreadedWriter (writer, thread, iNumSamples);
+}
+
+int DiskWriterPool::getNumThreads() const
+{
+    const juce::ScopedLock sl (lock);
+    return threads.size();
+}
+
+juce::TimeSliceThread& DiskWriterPool::getLeastBusyThread()
+{
+    juce::TimeSliceThread* best = nullptr;
+
+    for (auto* thread : threads)
+        if (best == nullptr || thread->getNumClients() < best->getNumClients())
+            best = thread;
+
+    // only add another I/O thread once the existing ones are busy
+    if (best == nullptr || (best->getNumClients() >= iWritersPerThread && threads.size() < iMaxThreads))
+    {
+        best = threads.add (new juce::TimeSliceThread ("Shared Disk Writer " + juce::String (threads.size() + 1)));
+        best->startThread();
+    }
+
+    return *best;
+}
@@ -0,0 +1,52 @@
+/*
+  ==============================================================================
+
+    DiskWriterPool.h
+    Created: 19 Oct 2026
+    Author:  Patrick Gammack
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+//==============================================================================
+/**
+    Process-wide set of disk writer threads shared by every plugin instance.
+    Hold it through juce::SharedResourcePointer<DiskWriterPool>.
+
+    Each TimeSliceThread services its writers round-robin, and a ThreadedWriter
+    writes at most a quarter of its FIFO per slice, so no single instance can
+    starve the others. Writers that have fallen idle wait between slices, which
+    lets their data build up into larger sequential writes.
+
+    Because a slow write on one file holds up every writer on that thread,
+    the pool sizes each FIFO from the number of writers it has to share with.
+*/
+
+class DiskWriterPool
+{
+public:
+    DiskWriterPool();
+    ~DiskWriterPool();
+
+    // takes ownership of writer; the returned object must be deleted before the pool.
+    // Locks and may start a thread, so call it from the message thread, not the audio thread.
+    juce::AudioFormatWriter::ThreadedWriter* createWriter (juce::AudioFormatWriter* writer);
+
+    int getNumThreads() const;
+
+private:
+    juce::TimeSliceThread& getLeastBusyThread();
+
+    static constexpr int iWritersPerThread = 8;
+    static constexpr int iMaxThreads = 2;
+    static constexpr double dSecondsPerWriter = 0.5; // on top of one second of headroom
+
+    juce::CriticalSection lock;
+    juce::OwnedArray<juce::TimeSliceThread> threads;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (DiskWriterPool)
+};
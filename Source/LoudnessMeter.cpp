@@ -0,0 +1,144 @@
+/*
+  ==============================================================================
+
+    LoudnessMeter.cpp
+    Created: 19 Oct 2026
+    Author:  Patrick Gammack
+
+  ==============================================================================
+*/
+
+#include "LoudnessMeter.h"
+
+//==============================================================================
+double LoudnessMeter::Biquad::process (double x, int channel)
+{
+    const double y = b0 * x + z1[channel];
+    z1[channel] = b1 * x - a1 * y + z2[channel];
+    z2[channel] = b2 * x - a2 * y;
+    return y;
+}
+
+//==============================================================================
+LoudnessMeter::LoudnessMeter()
+{
+    prepare (44100.0, 2);
+}
+
+void LoudnessMeter::prepare (double sampleRate, int numChannels)
+{
+    iNumChannels = juce::jlimit (1, 2, numChannels);
+    iSubBlockSize = juce::jmax (1, juce::roundToInt (sampleRate * 0.1));
+
+    // BS.1770 pre-filter: high shelf (head effect) then high-pass (RLB),
+    // recomputed for the running sample rate
+    const double pi = juce::MathConstants<double>::pi;
+    {
+        const double f0 = 1681.974450955533, G = 3.999843853973347, Q = 0.7071752369554196;
+        const double K = std::tan (pi * f0 / sampleRate);
+        const double Vh = std::pow (10.0, G / 20.0);
+        const double Vb = std::pow (Vh, 0.4996667741545416);
+        const double a0 = 1.0 + K / Q + K * K;
+
+        shelf.b0 = (Vh + Vb * K / Q + K * K) / a0;
+        shelf.b1 = 2.0 * (K * K - Vh) / a0;
+        shelf.b2 = (Vh - Vb * K / Q + K * K) / a0;
+        shelf.a1 = 2.0 * (K * K - 1.0) / a0;
+        shelf.a2 = (1.0 - K / Q + K * K) / a0;
+    }
+    {
+        const double f0 = 38.13547087602444, Q = 0.5003270373238773;
+        const double K = std::tan (pi * f0 / sampleRate);
+        const double a0 = 1.0 + K / Q + K * K;
+
+        highPass.b0 = 1.0;
+        highPass.b1 = -2.0;
+        highPass.b2 = 1.0;
+        highPass.a1 = 2.0 * (K * K - 1.0) / a0;
+        highPass.a2 = (1.0 - K / Q + K * K) / a0;
+    }
+
+    reset();
+}
+
+void LoudnessMeter::reset()
+{
+    for (int c = 0; c < 2; c++) {
+        shelf.z1[c] = shelf.z2[c] = 0.0;
+        highPass.z1[c] = highPass.z2[c] = 0.0;
+    }
+
+    iSubBlockPos = 0;
+    dSubBlockSum = 0.0;
+    iNumSubBlocks = 0;
+    for (int i = 0; i < 4; i++)
+        dSubBlocks[i] = 0.0;
+
+    dGatedSum = 0.0;
+    iNumGatedBlocks = 0;
+
+    fMomentary = fSilence;
+    fMaxMomentary = fSilence;
+    fIntegrated = fSilence;
+}
+
+void LoudnessMeter::process (const juce::AudioBuffer<float>& buffer)
+{
+    const int iChannels = juce::jmin (iNumChannels, buffer.getNumChannels());
+    const int iNumSamples = buffer.getNumSamples();
+
+    for (int i = 0; i < iNumSamples; i++)
+    {
+        for (int c = 0; c < iChannels; c++) {
+            const double y = highPass.process (shelf.process (buffer.getSample (c, i), c), c);
+            dSubBlockSum += y * y;
+        }
+
+        if (++iSubBlockPos < iSubBlockSize)
+            continue;
+
+        // every 100 ms, close a sub-block and re-evaluate the 400 ms window
+        dSubBlocks[iNumSubBlocks % 4] = dSubBlockSum / iSubBlockSize;
+        iNumSubBlocks++;
+        dSubBlockSum = 0.0;
+        iSubBlockPos = 0;
+
+        if (iNumSubBlocks < 4)
+            continue;
+
+        const double dMeanSquare = (dSubBlocks[0] + dSubBlocks[1] + dSubBlocks[2] + dSubBlocks[3]) * 0.25;
+        const float fLoudness = toLufs (dMeanSquare);
+
+        fMomentary = fLoudness;
+        if (fLoudness > fMaxMomentary.load())
+            fMaxMomentary = fLoudness;
+
+        if (fLoudness > -70.0f) { // absolute gate
+            dGatedSum += dMeanSquare;
+            iNumGatedBlocks++;
+            fIntegrated = toLufs (dGatedSum / (double) iNumGatedBlocks);
+        }
+    }
+}
+
+float LoudnessMeter::getMomentaryLoudness() const
+{
+    return fMomentary.load();
+}
+
+float LoudnessMeter::getMaxMomentaryLoudness() const
+{
+    return fMaxMomentary.load();
+}
+
+float LoudnessMeter::getIntegratedLoudness() const
+{
+    return fIntegrated.load();
+}
+
+float LoudnessMeter::toLufs (double meanSquare)
+{
+    if (meanSquare <= 0.0)
+        return fSilence;
+    return juce::jmax (fSilence, (float) (-0.691 + 10.0 * std::log10 (meanSquare)));
+}
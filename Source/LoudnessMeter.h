@@ -0,0 +1,70 @@
+/*
+  ==============================================================================
+
+    LoudnessMeter.h
+    Created: 19 Oct 2026
+    Author:  Patrick Gammack
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+//==============================================================================
+/**
+    K-weighted loudness meter following ITU-R BS.1770. process() is real-time
+    safe and is meant to be fed straight from processBlock.
+
+    Momentary loudness uses 400 ms windows updated every 100 ms. Integrated
+    loudness applies only the -70 LUFS absolute gate. Single-note takes rarely
+    have enough material for the relative gate to matter.
+*/
+
+class LoudnessMeter
+{
+public:
+    LoudnessMeter();
+    ~LoudnessMeter() {}
+
+    void prepare (double sampleRate, int numChannels);
+    void reset();
+    void process (const juce::AudioBuffer<float>& buffer);
+
+    float getMomentaryLoudness() const;     // LUFS, last 400 ms
+    float getMaxMomentaryLoudness() const;  // LUFS, loudest 400 ms since reset
+    float getIntegratedLoudness() const;    // LUFS since reset
+
+    static constexpr float fSilence = -100.0f;
+
+private:
+    struct Biquad
+    {
+        double b0, b1, b2, a1, a2;
+        double z1 [2], z2 [2];
+
+        double process (double x, int channel);
+    };
+
+    static float toLufs (double meanSquare);
+
+    Biquad shelf;
+    Biquad highPass;
+    int iNumChannels;
+
+    int iSubBlockSize;   // 100 ms
+    int iSubBlockPos;
+    double dSubBlockSum;
+    double dSubBlocks [4];
+    int iNumSubBlocks;
+
+    double dGatedSum;
+    juce::int64 iNumGatedBlocks;
+
+    std::atomic<float> fMomentary { fSilence };
+    std::atomic<float> fMaxMomentary { fSilence };
+    std::atomic<float> fIntegrated { fSilence };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (LoudnessMeter)
+};
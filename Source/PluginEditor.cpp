@@ -19,10 +19,11 @@ AutoSamplerAudioProcessorEditor::AutoSamplerAudioProcessorEditor (AutoSamplerAud
     iNoteIndex = 0;
     
     setResizable(true, false);
-    setSize (600, 400);
-    setResizeLimits(600, 400, 600, 400);
+    setSize (600 + iBrowserWidth, 400);
+    setResizeLimits(600 + iBrowserWidth, 400, 600 + iBrowserWidth, 400);
     
-    chooseDirectory();
+    if (audioProcessor.sampleDirectory.isEmpty()) // restored sessions already have one
+        chooseDirectory();
 
     recordState = RECORDING_OFF;
 //    addAndMakeVisible(&recordButton);
@@ -55,6 +56,12 @@ AutoSamplerAudioProcessorEditor::AutoSamplerAudioProcessorEditor (AutoSamplerAud
     restartButton.setColour(juce::TextButton::buttonColourId, colourButton);
     restartButton.setEnabled(false);
     
+    addAndMakeVisible(&exportButton);
+    exportButton.setButtonText("Export");
+    exportButton.setColour(juce::TextButton::buttonColourId, colourButton);
+    exportButton.onClick = [this] { exportButtonClicked(); };
+    exportButton.setEnabled(false);
+    
     addAndMakeVisible(&sampleSelection);
     sampleSelection.setText("Select Sample");
     sampleSelection.setColour(juce::ComboBox::backgroundColourId, colourButton);
@@ -68,6 +75,60 @@ AutoSamplerAudioProcessorEditor::AutoSamplerAudioProcessorEditor (AutoSamplerAud
     p.waveform.setColours(colourBox, colourAccent1);
     p.waveform.setRepaintRate(60);
     
+    addAndMakeVisible(&takeBrowser);
+    takeBrowser.setColours(colourBox, colourAccent1);
+    takeBrowser.onTakeChosen = [this] (const juce::File& file) {
+        if (runState == RUNNING)
+            return;
+        audioProcessor.loadPreview(audioProcessor.getPreviewDeck(), file);
+        if (!audioProcessor.isPreviewing())
+            audioProcessor.startPreview();
+    };
+    
+    addAndMakeVisible(&previewButton);
+    previewButton.setButtonText("Preview");
+    previewButton.setColour(juce::TextButton::buttonColourId, colourButton);
+    previewButton.onClick = [this] { previewButtonClicked(); };
+    
+    addAndMakeVisible(&deckButton);
+    deckButton.setButtonText(audioProcessor.getPreviewDeck() == 0 ? "A" : "B");
+    deckButton.setColour(juce::TextButton::buttonColourId, colourButton);
+    deckButton.onClick = [this] { deckButtonClicked(); };
+    
+    const char* layerNames [3] = { "p", "mf", "ff" };
+    for (int i=0; i<3; i++) {
+        juce::String layer (layerNames[i]);
+        addAndMakeVisible(&layerTargetSlider[i]);
+        layerTargetSlider[i].setSliderStyle(juce::Slider::LinearBar);
+        layerTargetSlider[i].setRange(-60.0, 0.0, 0.5);
+        layerTargetSlider[i].setColour(juce::Slider::backgroundColourId, colourBox);
+        layerTargetSlider[i].setColour(juce::Slider::trackColourId, colourAccent1.withAlpha(0.4f));
+        layerTargetSlider[i].setTooltip("Loudness target for the " + layer + " layer, in LUFS");
+        layerTargetSlider[i].textFromValueFunction = [layer] (double value) { return layer + " " + juce::String(value, 1); };
+        layerTargetSlider[i].valueFromTextFunction = [] (const juce::String& text) { return text.retainCharacters("-0123456789.").getDoubleValue(); };
+        layerTargetSlider[i].setValue(audioProcessor.fLayerTargetLoudness[i], juce::dontSendNotification);
+        layerTargetSlider[i].onValueChange = [this, i] { audioProcessor.fLayerTargetLoudness[i] = (float) layerTargetSlider[i].getValue(); };
+    }
+    
+    addAndMakeVisible(&toleranceSlider);
+    toleranceSlider.setSliderStyle(juce::Slider::LinearBar);
+    toleranceSlider.setRange(0.5, 12.0, 0.5);
+    toleranceSlider.setColour(juce::Slider::backgroundColourId, colourBox);
+    toleranceSlider.setColour(juce::Slider::trackColourId, colourAccent1.withAlpha(0.4f));
+    toleranceSlider.setTooltip("How far a take may miss its layer target, in LU");
+    toleranceSlider.textFromValueFunction = [] (double value) { return "+/- " + juce::String(value, 1) + " LU"; };
+    toleranceSlider.valueFromTextFunction = [] (const juce::String& text) { return text.retainCharacters("0123456789.").getDoubleValue(); };
+    toleranceSlider.setValue(audioProcessor.fLoudnessTolerance, juce::dontSendNotification);
+    toleranceSlider.onValueChange = [this] { audioProcessor.fLoudnessTolerance = (float) toleranceSlider.getValue(); };
+    
+    addAndMakeVisible(&autoRetakeButton);
+    autoRetakeButton.setButtonText("Auto Retake");
+    autoRetakeButton.setColour(juce::ToggleButton::textColourId, colourButton);
+    autoRetakeButton.setColour(juce::ToggleButton::tickColourId, colourAccent1);
+    autoRetakeButton.setTooltip("Stay on the same sample when a take misses its target");
+    autoRetakeButton.setToggleState(audioProcessor.bAutoRetake, juce::dontSendNotification);
+    autoRetakeButton.onClick = [this] { audioProcessor.bAutoRetake = autoRetakeButton.getToggleState(); };
+    
     addAndMakeVisible(&infoText[0]);
     infoText[0].setBoundingBox(infoTextBox[0]);
     infoText[0].setJustification(juce::Justification::centred);
@@ -87,7 +148,22 @@ AutoSamplerAudioProcessorEditor::AutoSamplerAudioProcessorEditor (AutoSamplerAud
     infoText[2].setJustification(juce::Justification::centred);
     infoText[2].setFontHeight(25.0f);
     infoText[2].setColour(colourAccent1);
-    infoText[2].setText(audioProcessor.sampleName[0]);
+    infoText[2].setText(audioProcessor.sampleName[audioProcessor.iSampleIndex]);
+    
+    addAndMakeVisible(&infoText[3]);
+    infoText[3].setBoundingBox(infoTextBox[3]);
+    infoText[3].setJustification(juce::Justification::centred);
+    infoText[3].setFontHeight(18.0f);
+    infoText[3].setColour(colourAccent1);
+    infoText[3].setText("");
+    
+    if (audioProcessor.sampleDirectory.isNotEmpty()) {
+        takeBrowser.setDirectory(juce::File(audioProcessor.sampleDirectory));
+        runButton.setEnabled(true);
+        nextNoteButton.setEnabled(audioProcessor.iSampleIndex < 35);
+        sampleSelection.setEnabled(true);
+        showTakeLoudness(); // restored from the take index
+    }
 }
 
 AutoSamplerAudioProcessorEditor::~AutoSamplerAudioProcessorEditor()
@@ -114,7 +190,7 @@ void AutoSamplerAudioProcessorEditor::paint (juce::Graphics& g)
 
 void AutoSamplerAudioProcessorEditor::resized()
 {
-    int iWindowWidth = getWidth();
+    int iWindowWidth = getWidth() - iBrowserWidth; // take browser sits to the right
     int iWindowHeight = getHeight();
     int iMargin = 15;
     
@@ -133,12 +209,58 @@ void AutoSamplerAudioProcessorEditor::resized()
     nextNoteButton.setBounds(runButton.getX(), runButton.getY() + runButton.getHeight() + iMargin, runButton.getWidth(), runButton.getHeight());
     resetNoteButton.setBounds(nextNoteButton.getX(), nextNoteButton.getY() + nextNoteButton.getHeight() + iMargin, nextNoteButton.getWidth(), nextNoteButton.getHeight());
     restartButton.setBounds(resetNoteButton.getX(), resetNoteButton.getY() + resetNoteButton.getHeight() + iMargin, resetNoteButton.getWidth(), resetNoteButton.getHeight());
-    sampleSelection.setBounds(resetNoteButton.getX(), resetNoteButton.getY() + resetNoteButton.getHeight() + iMargin, resetNoteButton.getWidth(), resetNoteButton.getHeight());
+    sampleSelection.setBounds(resetNoteButton.getX(), resetNoteButton.getY() + resetNoteButton.getHeight() + iMargin, resetNoteButton.getWidth()*0.5f - iMargin*0.5f, resetNoteButton.getHeight());
+    exportButton.setBounds(sampleSelection.getRight() + iMargin, sampleSelection.getY(), sampleSelection.getWidth(), sampleSelection.getHeight());
     timer.setBoundingBox(infoTextBox[0]);
+    takeBrowser.setBounds(iWindowWidth, iMargin, iBrowserWidth - iMargin, iWindowHeight - (iMargin*5) - 90);
+    int iColumnWidth = (takeBrowser.getWidth() - iMargin*2) / 3; // loudness settings sit under the browser
+    for (int i=0; i<3; i++)
+        layerTargetSlider[i].setBounds(takeBrowser.getX() + i*(iColumnWidth + iMargin), takeBrowser.getBottom() + iMargin, iColumnWidth, 30);
+    toleranceSlider.setBounds(takeBrowser.getX(), layerTargetSlider[0].getBottom() + iMargin, iColumnWidth, 30);
+    autoRetakeButton.setBounds(layerTargetSlider[1].getX(), toleranceSlider.getY(), takeBrowser.getRight() - layerTargetSlider[1].getX(), 30);
+    previewButton.setBounds(takeBrowser.getX(), toleranceSlider.getBottom() + iMargin, takeBrowser.getWidth() - 30 - iMargin, 30);
+    deckButton.setBounds(previewButton.getRight() + iMargin, previewButton.getY(), 30, 30);
 }
 
 void AutoSamplerAudioProcessorEditor::timerCallback()
 {
+    // print call sites the checker hasn't shown yet, about once a second
+    if (juce::Time::getMillisecondCounter() - iLastViolationPoll >= 1000) {
+        iLastViolationPoll = juce::Time::getMillisecondCounter();
+        
+        if (RealtimeSafetyChecker::getNumViolations() < iReportedViolations)
+            iReportedViolations = 0; // the table was cleared
+        
+        while (iReportedViolations < RealtimeSafetyChecker::getNumViolations()) {
+            auto report = RealtimeSafetyChecker::getViolationReport(iReportedViolations);
+            if (report.isEmpty())
+                break; // still being recorded, pick it up next time
+            DBG(report);
+            iReportedViolations++;
+        }
+    }
+    
+    if (audioProcessor.sampleDirectory.isNotEmpty())
+        exportButton.setEnabled(runState != RUNNING && !audioProcessor.isExporting());
+    
+    if (bExportRunning && !audioProcessor.isExporting()) {
+        bExportRunning = false;
+        auto failures = audioProcessor.getExportFailures();
+        infoText[0].setText(failures.isEmpty() ? "Export done" : "Export: " + juce::String(failures.size()) + " failed");
+        for (auto& failure : failures)
+            DBG("Export failed: " << failure);
+    }
+    
+    if (runState == RUNNING && audioProcessor.iCount <= 0) // live loudness against the layer target
+        infoText[3].setText(juce::String(audioProcessor.getCurrentLoudness(), 1) + " / "
+                            + juce::String(audioProcessor.getLayerTarget(audioProcessor.iSampleIndex), 0) + " LUFS");
+    
+    if (runState == RUNNING) // the last count stays up after Stop, until something else is shown
+        infoText[0].setText(audioProcessor.getNumDroppedBlocks() > 0 ? juce::String(audioProcessor.getNumDroppedBlocks()) + " blocks dropped" : "");
+    
+    previewButton.setEnabled(runState != RUNNING);
+    previewButton.setButtonText(audioProcessor.isPreviewing() ? "Stop Preview" : "Preview");
+    
     if (runState == RUNNING && audioProcessor.iCount >= 0) { // only run while counting down
         for (int i=0; i<=4; i++)
             if (audioProcessor.iCount == i)
@@ -168,10 +290,12 @@ void AutoSamplerAudioProcessorEditor::recordButtonClicked()
 
 void AutoSamplerAudioProcessorEditor::runButtonClicked()
 {
+    const int iTakesBefore = audioProcessor.getNumFinishedTakes();
     recordButtonClicked();
     
     switch (runState) {
         case SET:
+            audioProcessor.stopPreview();
             runState = RUNNING;
             runButton.setButtonText("Stop");
             nextNoteButton.setEnabled(true);
@@ -183,8 +307,12 @@ void AutoSamplerAudioProcessorEditor::runButtonClicked()
             runButton.setButtonText("Start");
             runButton.setEnabled(false);
             sampleSelection.setEnabled(true);
+            takeBrowser.refresh(); // pick up the take that just finished
+            if (audioProcessor.getNumFinishedTakes() > iTakesBefore) // not a stop during the count-down
+                showTakeLoudness();
             break;
         case PAUSED:
+            audioProcessor.stopPreview();
             runState = RUNNING;
             runButton.setButtonText("Stop");
             runButton.setEnabled(true);
@@ -201,6 +329,14 @@ void AutoSamplerAudioProcessorEditor::nextNoteButtonClicked()
         runButton.setEnabled(true);
     
     infoText[1].setText("4");
+    
+    // judged on this slot's last take, however it was stopped
+    if (audioProcessor.bAutoRetake && audioProcessor.getLastTakeSlot() == audioProcessor.iSampleIndex
+        && audioProcessor.lastTakeNeedsRetake()) {
+        showTakeLoudness();
+        infoText[3].setText("RETAKE " + infoText[3].getText());
+        return; // stay on this slot
+    }
 
     if (audioProcessor.iSampleIndex < 35) { // prevent index from exceeding array size
         audioProcessor.iSampleIndex++;
@@ -240,6 +376,49 @@ void AutoSamplerAudioProcessorEditor::sampleSelectionChanged()
     sampleSelection.setText("Select Sample");
 }
 
+void AutoSamplerAudioProcessorEditor::showTakeLoudness()
+{
+    if (audioProcessor.getLastTakeSlot() < 0) {
+        infoText[3].setText("");
+        return;
+    }
+    
+    float fDeviation = audioProcessor.getLastTakeLoudness() - audioProcessor.getLayerTarget(audioProcessor.getLastTakeSlot());
+    juce::String text = juce::String(audioProcessor.getLastTakeLoudness(), 1) + " LUFS";
+    
+    if (audioProcessor.lastTakeNeedsRetake())
+        text << (fDeviation < 0 ? " too quiet" : " too loud");
+    else
+        text << " ok";
+    
+    infoText[3].setText(text);
+}
+
+void AutoSamplerAudioProcessorEditor::exportButtonClicked()
+{
+    exportButton.setEnabled(false);
+    
+    auto result = audioProcessor.exportSamples();
+    if (result.failed())
+        infoText[0].setText(result.getErrorMessage());
+    else
+        bExportRunning = true;
+}
+
+void AutoSamplerAudioProcessorEditor::previewButtonClicked()
+{
+    if (audioProcessor.isPreviewing())
+        audioProcessor.stopPreview();
+    else
+        audioProcessor.startPreview();
+}
+
+void AutoSamplerAudioProcessorEditor::deckButtonClicked()
+{
+    audioProcessor.setPreviewDeck(1 - audioProcessor.getPreviewDeck());
+    deckButton.setButtonText(audioProcessor.getPreviewDeck() == 0 ? "A" : "B");
+}
+
 void AutoSamplerAudioProcessorEditor::chooseDirectory()
 {
     directoryChooser = std::make_unique<juce::FileChooser> ("Select a location to save samples...",
@@ -253,8 +432,8 @@ void AutoSamplerAudioProcessorEditor::chooseDirectory()
         
         auto file = fc.getResult();
         
-        if (file != juce::File{}) {
-            audioProcessor.sampleDirectory = file.getFullPathName();
+        if (file != juce::File{} && audioProcessor.setSampleDirectory(file.getFullPathName())) {
+            takeBrowser.setDirectory(file);
             runButton.setEnabled(true);
             nextNoteButton.setEnabled(true);
             sampleSelection.setEnabled(true);
@@ -10,6 +10,7 @@
 
 #include <JuceHeader.h>
 #include "PluginProcessor.h"
+#include "TakeBrowser.h"
 
 //==============================================================================
 /**
@@ -107,6 +108,10 @@ public:
     void nextNoteButtonClicked();
     void resetNoteButtonClicked();
     void sampleSelectionChanged();
+    void exportButtonClicked();
+    void showTakeLoudness();
+    void previewButtonClicked();
+    void deckButtonClicked();
     void chooseDirectory();
 
 private:
@@ -123,6 +128,9 @@ private:
     
     int iDynIndex;
     int iNoteIndex;
+    int iReportedViolations = 0;
+    bool bExportRunning = false;
+    juce::uint32 iLastViolationPoll = 0;
     
     // COLOURS
     juce::Colour colourBackground = juce::Colour(28,28,28);
@@ -143,8 +151,21 @@ private:
     juce::TextButton nextNoteButton;
     juce::TextButton resetNoteButton;
     juce::TextButton restartButton;
+    juce::TextButton exportButton;
     juce::ComboBox sampleSelection;
     
+    // TAKES
+    TakeBrowser takeBrowser;
+    juce::TextButton previewButton;
+    juce::TextButton deckButton;
+    int iBrowserWidth = 300;
+    
+    // LOUDNESS
+    juce::Slider layerTargetSlider [3];
+    juce::Slider toleranceSlider;
+    juce::ToggleButton autoRetakeButton;
+    juce::TooltipWindow tooltipWindow { this };
+    
     // TEXT
     juce::DrawableText infoText [4];
     
@@ -44,16 +44,78 @@ AutoSamplerAudioProcessor::AutoSamplerAudioProcessor()
     iSample = 0;
     iCountDown = 0;
     iCount = 0;
+    iLastTakeSlot = -1;
+    iFinishedTakes = 0;
+    iJournalledSlot = -1;
+    fPeak = 0;
+    fLastTakeLoudness = LoudnessMeter::fSilence;
+    fLayerTargetLoudness[0] = -32.0f;
+    fLayerTargetLoudness[1] = -24.0f;
+    fLayerTargetLoudness[2] = -16.0f;
+    fLoudnessTolerance = 3.0f;
+    bAutoRetake = false;
     iTimeStamps.clear();
+    exportTargets.add ({ 44100.0, 24 });
+    exportTargets.add ({ 48000.0, 24 });
     formatManager.registerBasicFormats();
-    transportSource.addChangeListener(this);
-    recordThread.startThread();
+    for (int i=0; i<2; i++)
+        transportSource[i].addChangeListener(this);
+    readAheadThread.startThread();
     waveform.clear();
 }
 
 AutoSamplerAudioProcessor::~AutoSamplerAudioProcessor()
 {
     stopRecording();
+    stopPreview();
+    for (int i=0; i<2; i++) {
+        transportSource[i].removeChangeListener(this);
+        transportSource[i].setSource(nullptr);
+    }
+}
+
+bool AutoSamplerAudioProcessor::setSampleDirectory (const juce::String& directory)
+{
+    // the take in progress belongs to the current directory's journal and index
+    if (recordState != RECORDING_OFF)
+        return false;
+    
+    sampleDirectory = directory;
+    takeIndex.open(juce::File(directory));
+    
+    // restore any takes a previous session crashed out of
+    for (auto& take : journal.open(juce::File(directory))) {
+        if (take.file.hasFileExtension("recording")) { // finish the move to its final name
+            if (take.iLengthSamples == 0) {
+                take.file.deleteFile(); // interrupted during the count-down; the old take stands
+                continue;
+            }
+            if (!take.file.moveFileTo(take.file.getSiblingFile(take.file.getFileNameWithoutExtension())))
+                continue;
+        }
+        
+        if (auto* record = takeIndex.getRecord(take.iSlot)) {
+            // a new take whose measurements died with the session; don't keep the old ones
+            record->iFlags |= TakeRecord::RECORDED;
+            record->iFlags &= ~TakeRecord::OUT_OF_TOLERANCE;
+            record->iNumTakes++;
+            record->iLengthSamples = take.iLengthSamples;
+            record->iRecordedTime = juce::Time::currentTimeMillis();
+            record->dSampleRate = take.dSampleRate;
+            record->fPeak = 0;
+            record->fLoudness = LoudnessMeter::fSilence;
+        }
+    }
+    
+    // the last take's loudness lives on in the index, so a restored session can still show it
+    fLastTakeLoudness = LoudnessMeter::fSilence;
+    auto* record = takeIndex.getRecord(iLastTakeSlot);
+    if (record != nullptr && (record->iFlags & TakeRecord::RECORDED))
+        fLastTakeLoudness = record->fLoudness;
+    else
+        iLastTakeSlot = -1;
+    
+    return true;
 }
 
 void AutoSamplerAudioProcessor::armRecording()
@@ -61,56 +123,297 @@ void AutoSamplerAudioProcessor::armRecording()
     dSampleRate = getSampleRate();
     iCountDown = dSampleRate * 4; // 4 seconds
     iCount = 4;
-    recordState = RECORD_ARMED;
-    runState = RUNNING;
-}
-void AutoSamplerAudioProcessor::startRecording()
-{
-    if (recordState == RECORD_ARMED)
+    stopPreview(); // the take replaces a file a deck may have open
+    
+    // Everything that allocates, opens files or waits on the shared writer pool
+    // happens here, on the message thread; startRecording() only switches the
+    // writer on. The take is written next to its final name and only replaces
+    // the previous take once it finishes, so stopping during the count-down
+    // leaves that take alone.
+    outputFile = juce::File(sampleDirectory + "/" + sampleName[iSampleIndex] + ".wav");
+    recordingFile = outputFile.getSiblingFile(outputFile.getFileName() + ".recording");
+    journal.beginTake(iSampleIndex, recordingFile);
+    iJournalledSlot = iSampleIndex;
+    
+    if (dSampleRate > 0)
     {
-        dSampleRate = getSampleRate();
+        recordingFile.deleteFile();
         
-        if (dSampleRate)
+        if (auto outputStream = std::unique_ptr<juce::FileOutputStream> (recordingFile.createOutputStream()))
         {
-            juce::String file = sampleDirectory + "/" + sampleName[iSampleIndex] + ".wav";
-            outputFile.operator=(file); // change file name
-            outputFile.deleteFile();
-            outputFile.create(); // overwrite existing file
-
-            if (auto outputStream = std::unique_ptr<juce::FileOutputStream> (outputFile.createOutputStream()))
+            juce::WavAudioFormat wavFormat;
+            
+            if (auto writer = wavFormat.createWriterFor(outputStream.get(), dSampleRate, 2, 24, {}, 0))
             {
-                juce::WavAudioFormat wavFormat;
-                
-                if (auto writer = wavFormat.createWriterFor(outputStream.get(), dSampleRate, 2, 24, {}, 0))
-                {
-                    outputStream.release();
-                    threadedWriter.reset(new juce::AudioFormatWriter::ThreadedWriter(writer, recordThread, 32768));
-                    
-                    const juce::ScopedLock sl (writerLock);
-                    recordState = RECORDING;
-                    activeWriter = threadedWriter.get();
-                    iSample = 0;
-                    iTimeStamps.clear();
-                    iTimeStamps.push_back(0);
-                    printf("RECORDING ACTIVE\n");
-                }
+                outputStream.release();
+                threadedWriter.reset(writerPool->createWriter(writer));
+                threadedWriter->setFlushInterval((int) dSampleRate); // rewrite the header about once a second, on the writer thread
             }
         }
     }
+    
+    iTimeStamps.clear();
+    iTimeStamps.push_back(0);
+    
+    const juce::ScopedLock sl (writerLock);
+    recordState = RECORD_ARMED;
+    runState = RUNNING;
+}
+void AutoSamplerAudioProcessor::startRecording()
+{
+    // audio thread: publish the writer armRecording() made, nothing more
+    const juce::ScopedLock sl (writerLock);
+    
+    if (recordState == RECORD_ARMED && threadedWriter != nullptr)
+    {
+        recordState = RECORDING;
+        activeWriter = threadedWriter.get();
+        iSample = 0;
+        iDroppedBlocks = 0;
+        fPeak = 0;
+        loudnessMeter.reset();
+    }
 }
 
 void AutoSamplerAudioProcessor::stopRecording()
 {
+    bool bWasRecording;
     {
         const juce::ScopedLock sl (writerLock);
         activeWriter = nullptr;
+        bWasRecording = (recordState == RECORDING);
+        recordState = RECORDING_OFF; // startRecording() can't publish the writer after this
     }
     
-    recordState = RECORDING_OFF;
     runState = NOT_RUNNING;
-    threadedWriter.reset();
+    threadedWriter.reset(); // finalises the file
     iTimeStamps.push_back(iSample);
+    
+    if (iJournalledSlot >= 0) { // also closes takes stopped during the count-down
+        // a finished take replaces the previous one, a cancelled one is thrown away;
+        // if the old file can't be replaced the take is kept as .recording
+        if (bWasRecording)
+            bWasRecording = recordingFile.moveFileTo(outputFile);
+        else
+            recordingFile.deleteFile();
+        
+        journal.endTake(iJournalledSlot);
+        iJournalledSlot = -1;
+    }
+    
+    if (bWasRecording) {
+        iLastTakeSlot = iSampleIndex;
+        iFinishedTakes++;
+        fLastTakeLoudness = loudnessMeter.getMaxMomentaryLoudness();
+        
+        if (auto* record = takeIndex.getRecord(iSampleIndex)) {
+            record->iFlags |= TakeRecord::RECORDED;
+            record->iNumTakes++;
+            record->iLengthSamples = iSample;
+            record->iRecordedTime = juce::Time::currentTimeMillis();
+            record->dSampleRate = dSampleRate;
+            record->fPeak = fPeak;
+            record->fLoudness = fLastTakeLoudness;
+            
+            if (lastTakeNeedsRetake())
+                record->iFlags |= TakeRecord::OUT_OF_TOLERANCE;
+            else
+                record->iFlags &= ~TakeRecord::OUT_OF_TOLERANCE;
+        }
+    }
+}
+
+juce::Result AutoSamplerAudioProcessor::exportSamples()
+{
+    if (sampleDirectory.isEmpty() || isExporting())
+        return juce::Result::ok();
+    
+    juce::File directory (sampleDirectory);
+    juce::Array<juce::File> sources;
+    
+    for (int i=0; i<36; i++) {
+        auto file = directory.getChildFile(juce::String(sampleName[i]) + ".wav");
+        if (file.existsAsFile())
+            sources.add(file);
+    }
+    
+    auto exportDirectory = directory.getChildFile("Export");
+    sampleExporter.exportFiles(sources, exportDirectory, exportTargets);
+    
+    auto splits = getVelocitySplitSuggestions();
+    if (splits.isNotEmpty()) {
+        // the export jobs create their own folders on the pool threads, so this may run first
+        auto result = exportDirectory.createDirectory();
+        if (result.failed())
+            return result;
+        if (!exportDirectory.getChildFile("VelocitySplits.txt").replaceWithText(splits))
+            return juce::Result::fail("Couldn't write VelocitySplits.txt");
+    }
+    
+    return juce::Result::ok();
+}
+
+bool AutoSamplerAudioProcessor::isRecording() const
+{
+    return recordState == RECORDING;
+}
+
+int AutoSamplerAudioProcessor::getNumDroppedBlocks() const
+{
+    return iDroppedBlocks.load();
+}
+
+bool AutoSamplerAudioProcessor::isExporting() const
+{
+    return sampleExporter.isExporting();
+}
+
+juce::StringArray AutoSamplerAudioProcessor::getExportFailures() const
+{
+    return sampleExporter.getFailures();
+}
+float AutoSamplerAudioProcessor::getCurrentLoudness() const
+{
+    return loudnessMeter.getMomentaryLoudness();
+}
+
+float AutoSamplerAudioProcessor::getLayerTarget (int slot) const
+{
+    return fLayerTargetLoudness[juce::jlimit(0, 2, slot / 12)]; // sampleName is laid out layer by layer
+}
+
+int AutoSamplerAudioProcessor::getLastTakeSlot() const
+{
+    return iLastTakeSlot;
+}
+
+int AutoSamplerAudioProcessor::getNumFinishedTakes() const
+{
+    return iFinishedTakes;
+}
+
+float AutoSamplerAudioProcessor::getLastTakeLoudness() const
+{
+    return fLastTakeLoudness;
+}
+
+bool AutoSamplerAudioProcessor::lastTakeNeedsRetake() const
+{
+    if (iLastTakeSlot < 0)
+        return false;
+    return std::abs(fLastTakeLoudness - getLayerTarget(iLastTakeSlot)) > fLoudnessTolerance;
+}
+
+juce::String AutoSamplerAudioProcessor::getVelocitySplitSuggestions()
+{
+    // Velocity is taken to follow the square root of amplitude (40 dB per decade),
+    // scaled so that the loudest layer of each note reaches 127. Splits fall at
+    // the midpoint in dB between neighbouring layers.
+    juce::String text;
+    
+    for (int n = 0; n < 12; n++)
+    {
+        int iLayers [3];
+        float fLoudness [3];
+        int iNumLayers = 0;
+        
+        for (int d = 0; d < 3; d++) {
+            auto* record = takeIndex.getRecord(d*12+n);
+            if (record != nullptr && (record->iFlags & TakeRecord::RECORDED) && record->fLoudness > LoudnessMeter::fSilence) {
+                iLayers[iNumLayers] = d*12+n;
+                fLoudness[iNumLayers] = record->fLoudness;
+                iNumLayers++;
+            }
+        }
+        
+        // order quietest first, whatever the layer labels say
+        for (int i = 1; i < iNumLayers; i++)
+            for (int j = i; j > 0 && fLoudness[j] < fLoudness[j-1]; j--) {
+                std::swap(fLoudness[j], fLoudness[j-1]);
+                std::swap(iLayers[j], iLayers[j-1]);
+            }
+        
+        int iLow = 1;
+        for (int i = 0; i < iNumLayers; i++)
+        {
+            int iHigh = 127;
+            if (i < iNumLayers - 1) {
+                const float fSplit = (fLoudness[i] + fLoudness[i+1]) * 0.5f;
+                iHigh = juce::jlimit(iLow, 127 - (iNumLayers - 1 - i), juce::roundToInt(127.0f * std::pow(10.0f, (fSplit - fLoudness[iNumLayers-1]) / 40.0f)));
+            }
+            text << sampleName[iLayers[i]] << "\t" << juce::String(fLoudness[i], 1) << " LUFS\t" << iLow << "-" << iHigh << "\n";
+            iLow = iHigh + 1;
+        }
+    }
+    
+    return text;
+}
+
+void AutoSamplerAudioProcessor::loadPreview (int deck, const juce::File& file)
+{
+    if (deck < 0 || deck > 1)
+        return;
+    
+    previewFile[deck] = file;
+    
+    if (auto* reader = formatManager.createReaderFor(file))
+    {
+        auto newSource = std::make_unique<juce::AudioFormatReaderSource>(reader, true);
+        
+        // the transport reads through a BufferingAudioSource on readAheadThread,
+        // so the audio thread only ever copies from memory
+        transportSource[deck].setSource(newSource.get(), 65536, &readAheadThread, reader->sampleRate, (int) reader->numChannels);
+        readerSource[deck].reset(newSource.release());
+        
+        if (bPreviewing) { // join the other deck at the same position
+            transportSource[deck].setPosition(transportSource[1-deck].getCurrentPosition());
+            transportSource[deck].start();
+        }
+    }
+}
+
+void AutoSamplerAudioProcessor::startPreview()
+{
+    if (recordState != RECORDING_OFF)
+        return;
+    
+    for (int i=0; i<2; i++) {
+        if (readerSource[i] == nullptr && previewFile[i] != juce::File{})
+            loadPreview(i, previewFile[i]); // released by the last stopPreview()
+        transportSource[i].setPosition(0.0);
+        transportSource[i].start();
+    }
+    bPreviewing = true;
 }
+
+void AutoSamplerAudioProcessor::stopPreview()
+{
+    bPreviewing = false;
+    
+    // close the files too: a retake deletes and rewrites the same file, which
+    // fails on Windows while a reader still has it open
+    for (int i=0; i<2; i++) {
+        transportSource[i].stop();
+        transportSource[i].setSource(nullptr);
+        readerSource[i].reset();
+    }
+}
+
+void AutoSamplerAudioProcessor::setPreviewDeck (int deck)
+{
+    iPreviewDeck = juce::jlimit(0, 1, deck); // picked up at the start of the next block
+}
+
+int AutoSamplerAudioProcessor::getPreviewDeck() const
+{
+    return iPreviewDeck.load();
+}
+
+bool AutoSamplerAudioProcessor::isPreviewing() const
+{
+    return bPreviewing.load();
+}
+
 //==============================================================================
 const juce::String AutoSamplerAudioProcessor::getName() const
 {
@@ -179,12 +482,19 @@ void AutoSamplerAudioProcessor::prepareToPlay (double sampleRate, int samplesPer
     // Use this method as the place to do any pre-playback
     // initialisation that you need..
     dSampleRate = sampleRate;
+    
+    previewBuffer.setSize(2, samplesPerBlock);
+    loudnessMeter.prepare(sampleRate, 2);
+    for (int i=0; i<2; i++)
+        transportSource[i].prepareToPlay(samplesPerBlock, sampleRate);
 }
 
 void AutoSamplerAudioProcessor::releaseResources()
 {
     // When playback stops, you can use this as an opportunity to free up any
     // spare memory, etc.
+    for (int i=0; i<2; i++)
+        transportSource[i].releaseResources();
 }
 
 #ifndef JucePlugin_PreferredChannelConfigurations
@@ -215,6 +525,8 @@ bool AutoSamplerAudioProcessor::isBusesLayoutSupported (const BusesLayout& layou
 
 void AutoSamplerAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages)
 {
+    RealtimeSafetyChecker::ScopedAudioThread rtCheck; // no-op unless SAMPLEASSIST_RT_CHECKS
+    
     dSampleRate = getSampleRate();
     iBufferSize = buffer.getNumSamples();
     
@@ -268,10 +580,31 @@ void AutoSamplerAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
         // ..do something to the data...
         if (activeWriter.load() != nullptr)
         {
-            if (recordState == RECORDING)
-                activeWriter.load() -> write(buffer.getArrayOfReadPointers(), buffer.getNumSamples());
+            if (recordState == RECORDING) {
+                if (!activeWriter.load() -> write(buffer.getArrayOfReadPointers(), buffer.getNumSamples()))
+                    iDroppedBlocks++; // FIFO full: the disk fell behind and this block is lost
+                iSample += buffer.getNumSamples();
+                loudnessMeter.process(buffer);
+                fPeak = juce::jmax(fPeak, buffer.getMagnitude(0, buffer.getNumSamples()));
+            }
         }
 //    }
+    
+    if (bPreviewing && recordState == RECORDING_OFF)
+    {
+        // replace the monitored input with the selected deck, and run the other
+        // deck alongside so an A/B switch lands at the same position
+        const int iDeck = iPreviewDeck.load();
+        const int iNumSamples = buffer.getNumSamples();
+        
+        juce::AudioSourceChannelInfo info (&buffer, 0, iNumSamples);
+        transportSource[iDeck].getNextAudioBlock(info);
+        
+        for (int iPos = 0; iPos < iNumSamples && previewBuffer.getNumSamples() > 0; iPos += previewBuffer.getNumSamples()) {
+            juce::AudioSourceChannelInfo other (&previewBuffer, 0, juce::jmin(iNumSamples - iPos, previewBuffer.getNumSamples()));
+            transportSource[1-iDeck].getNextAudioBlock(other);
+        }
+    }
 }
 
 //==============================================================================
@@ -286,23 +619,94 @@ juce::AudioProcessorEditor* AutoSamplerAudioProcessor::createEditor()
 }
 
 //==============================================================================
+// Session state is kept small and fixed-size; per-take data lives in the
+// TakeIndex file in the sample directory rather than in the host project.
+static const int iStateMagic = 0x53417373; // "SAss"
+static const int iStateVersion = 2; // 2: loudness targets, tolerance and auto-retake
+
 void AutoSamplerAudioProcessor::getStateInformation (juce::MemoryBlock& destData)
 {
-    // You should use this method to store your parameters in the memory block.
-    // You could do that either as raw data, or use the XML or ValueTree classes
-    // as intermediaries to make it easy to save and load complex data.
+    juce::MemoryOutputStream stream (destData, false);
+    
+    stream.writeInt(iStateMagic);
+    stream.writeInt(iStateVersion);
+    stream.writeString(sampleDirectory);
+    stream.writeInt(iSampleIndex);
+    stream.writeInt(iLastTakeSlot);
+    
+    stream.writeInt(exportTargets.size());
+    for (auto& target : exportTargets) {
+        stream.writeDouble(target.sampleRate);
+        stream.writeInt(target.bitDepth);
+    }
+    
+    for (int i=0; i<3; i++)
+        stream.writeFloat(fLayerTargetLoudness[i]);
+    stream.writeFloat(fLoudnessTolerance);
+    stream.writeBool(bAutoRetake);
 }
 
 void AutoSamplerAudioProcessor::setStateInformation (const void* data, int sizeInBytes)
 {
-    // You should use this method to restore your parameters from this memory block,
-    // whose contents will have been created by the getStateInformation() call.
+    juce::MemoryInputStream stream (data, (size_t) sizeInBytes, false);
+    
+    if (stream.readInt() != iStateMagic)
+        return;
+    
+    const int iVersion = stream.readInt();
+    if (iVersion < 1 || iVersion > iStateVersion)
+        return;
+    
+    auto directory = stream.readString();
+    iSampleIndex = juce::jlimit(0, 35, stream.readInt());
+    iLastTakeSlot = juce::jlimit(-1, 35, stream.readInt());
+    
+    const int iNumTargets = stream.readInt();
+    if (iNumTargets > 0) {
+        exportTargets.clearQuick();
+        for (int i=0; i<iNumTargets && !stream.isExhausted(); i++) {
+            ExportTarget target;
+            target.sampleRate = stream.readDouble();
+            target.bitDepth = stream.readInt();
+            exportTargets.add(target);
+        }
+    }
+    
+    if (iVersion >= 2) {
+        for (int i=0; i<3; i++)
+            fLayerTargetLoudness[i] = juce::jlimit(-60.0f, 0.0f, stream.readFloat());
+        fLoudnessTolerance = juce::jlimit(0.5f, 12.0f, stream.readFloat());
+        bAutoRetake = stream.readBool();
+    }
+    
+    if (directory.isNotEmpty() && juce::File(directory).isDirectory())
+        setSampleDirectory(directory);
 }
 
 //==============================================================================
 // This creates new instances of the plugin..
 juce::AudioProcessor* JUCE_CALLTYPE createPluginFilter()
 {
+   #if SAMPLEASSIST_RT_CHECKS && JucePlugin_Build_Standalone
+    // "SampleAssist --run-tests" runs the SampleAssist unit tests, then quits with
+    // a non-zero exit code if any of them failed
+    static bool bTestsRun = false;
+    if (!bTestsRun && juce::JUCEApplicationBase::isStandaloneApp()
+        && juce::JUCEApplicationBase::getCommandLineParameterArray().contains("--run-tests")) {
+        bTestsRun = true;
+        
+        juce::UnitTestRunner runner;
+        runner.runTestsInCategory("SampleAssist");
+        
+        int iFailures = 0;
+        for (int i=0; i<runner.getNumResults(); i++)
+            iFailures += runner.getResult(i)->failures;
+        
+        if (auto* app = juce::JUCEApplicationBase::getInstance())
+            app->setApplicationReturnValue(iFailures > 0 ? 1 : 0);
+        juce::JUCEApplicationBase::quit();
+    }
+   #endif
     return new AutoSamplerAudioProcessor();
 }
 
@@ -9,6 +9,12 @@
 #pragma once
 
 #include <JuceHeader.h>
+#include "SampleExporter.h"
+#include "TakeIndex.h"
+#include "DiskWriterPool.h"
+#include "RealtimeSafetyChecker.h"
+#include "LoudnessMeter.h"
+#include "RecordingJournal.h"
 
 //==============================================================================
 /**
@@ -38,7 +44,8 @@ public:
     AutoSamplerAudioProcessor();
     ~AutoSamplerAudioProcessor() override;
     void changeListenerCallback (juce::ChangeBroadcaster* source) override {
-        
+        if (!transportSource[0].isPlaying() && !transportSource[1].isPlaying())
+            bPreviewing = false; // both decks reached the end
     }
 
     //==============================================================================
@@ -74,10 +81,43 @@ public:
     void getStateInformation (juce::MemoryBlock& destData) override;
     void setStateInformation (const void* data, int sizeInBytes) override;
     
+    //==============================================================================
+    bool setSampleDirectory (const juce::String& directory); // false while a take is armed or recording
+    
     //==============================================================================
     void armRecording();
     void startRecording();
     void stopRecording();
+    bool isRecording() const;
+    int getNumDroppedBlocks() const; // blocks of the current take the disk writer couldn't accept
+    
+    //==============================================================================
+    juce::Result exportSamples(); // the export itself carries on in the background
+    bool isExporting() const;
+    juce::StringArray getExportFailures() const;
+    
+    juce::Array<ExportTarget> exportTargets;
+    
+    //==============================================================================
+    float getCurrentLoudness() const;
+    float getLayerTarget (int slot) const;
+    int getLastTakeSlot() const;     // -1 until a take has been recorded in this directory
+    int getNumFinishedTakes() const; // goes up each time stopRecording() ends a running take
+    float getLastTakeLoudness() const;
+    bool lastTakeNeedsRetake() const;
+    juce::String getVelocitySplitSuggestions();
+    
+    float fLayerTargetLoudness [3]; // LUFS per dynamic layer, p/mf/ff
+    float fLoudnessTolerance;       // +/- LU around the target
+    bool bAutoRetake;
+    
+    //==============================================================================
+    void loadPreview (int deck, const juce::File& file);
+    void startPreview();
+    void stopPreview();
+    void setPreviewDeck (int deck);
+    int getPreviewDeck() const;
+    bool isPreviewing() const;
 
     juce::AudioVisualiserComponent waveform;
 
@@ -86,15 +126,27 @@ private:
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AutoSamplerAudioProcessor)
     
     juce::AudioFormatManager formatManager;
-    std::unique_ptr<juce::AudioFormatReaderSource> readerSource;
-    juce::AudioTransportSource transportSource;
+    // two preview decks for A/B, both fed through a background read-ahead buffer
+    juce::TimeSliceThread readAheadThread { "Preview Read-Ahead Thread" };
+    std::unique_ptr<juce::AudioFormatReaderSource> readerSource [2];
+    juce::File previewFile [2]; // reloaded by startPreview() after stopPreview() closed it
+    juce::AudioTransportSource transportSource [2];
+    juce::AudioBuffer<float> previewBuffer;
+    std::atomic<int> iPreviewDeck { 0 };
+    std::atomic<bool> bPreviewing { false };
     
     std::unique_ptr<juce::AudioFormatWriter> audioWriter;
     
-    juce::TimeSliceThread recordThread { "Audio Recorder Thread" };
-    std::unique_ptr<juce::AudioFormatWriter::ThreadedWriter> threadedWriter;
+    juce::SharedResourcePointer<DiskWriterPool> writerPool; // shared with other instances
+    std::unique_ptr<juce::AudioFormatWriter::ThreadedWriter> threadedWriter; // created by armRecording()
     juce::CriticalSection writerLock;
     std::atomic<juce::AudioFormatWriter::ThreadedWriter*> activeWriter { nullptr };
+    std::atomic<int> iDroppedBlocks { 0 };
+    
+    SampleExporter sampleExporter;
+    TakeIndex takeIndex;
+    LoudnessMeter loudnessMeter;
+    RecordingJournal journal;
     
     std::string dynamicLayers [3];
     std::string notes [12];
@@ -102,10 +154,16 @@ private:
     RunState runState;
     RecordState recordState;
     juce::File outputFile;
+    juce::File recordingFile; // outputFile + ".recording" while a take is armed or recording
     
     int iCountDown;
     int iBufferSize;
     int iSample;
+    int iLastTakeSlot;
+    int iFinishedTakes;
+    int iJournalledSlot; // slot with a begin entry in the journal and no end yet
+    float fPeak;
+    float fLastTakeLoudness;
     double dSampleRate;
     
     std::vector<int> iTimeStamps;
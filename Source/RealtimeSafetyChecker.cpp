@@ -0,0 +1,567 @@
+/*
+  ==============================================================================
+
+    RealtimeSafetyChecker.cpp
+    Created: 19 Oct 2026
+    Author:  Patrick Gammack
+
+  ==============================================================================
+*/
+
+#include "RealtimeSafetyChecker.h"
+
+#if SAMPLEASSIST_RT_CHECKS
+
+#include <new>
+#include <cstdlib>
+
+#if JUCE_MAC || JUCE_LINUX
+ #include <cstdarg>
+ #include <cstdio>
+ #include <dlfcn.h>
+ #include <execinfo.h>
+ #include <fcntl.h>
+ #include <pthread.h>
+ #include <sys/stat.h>
+ #include <unistd.h>
+#endif
+
+//==============================================================================
+namespace
+{
+    struct Violation
+    {
+        std::atomic<int> iCount;
+        std::atomic<bool> bReady;
+        RealtimeSafetyChecker::ViolationType type;
+        const char* function;
+        int iNumFrames;
+        void* frames[32];
+    };
+
+    const int iMaxViolations = 128;
+    const int iSkipFrames = 2; // check() and the hook itself
+
+    Violation violations [iMaxViolations];
+    std::atomic<int> iNumViolations { 0 };
+    std::atomic<int> iChecksInFlight { 0 };
+    std::atomic<bool> bClearing { false };
+
+    // plain initial-exec TLS, so that touching it never allocates (and never
+    // re-enters the malloc hooks below)
+   #if JUCE_LINUX
+    #define SAMPLEASSIST_TLS thread_local __attribute__((tls_model ("initial-exec")))
+   #else
+    #define SAMPLEASSIST_TLS thread_local
+   #endif
+    SAMPLEASSIST_TLS int iAudioThreadDepth = 0;
+    SAMPLEASSIST_TLS bool bInsideCheck = false;
+
+    bool isSameCallSite (const Violation& v, RealtimeSafetyChecker::ViolationType type, void* const* frames, int numFrames)
+    {
+        return v.bReady.load() && v.type == type && v.iNumFrames == numFrames
+            && std::memcmp (v.frames, frames, sizeof (void*) * (size_t) numFrames) == 0;
+    }
+}
+
+RealtimeSafetyChecker::ScopedAudioThread::ScopedAudioThread()
+{
+    iAudioThreadDepth++;
+}
+
+RealtimeSafetyChecker::ScopedAudioThread::~ScopedAudioThread()
+{
+    iAudioThreadDepth--;
+}
+
+void RealtimeSafetyChecker::record (ViolationType type, const char* function) noexcept
+{
+    void* frames[32 + iSkipFrames] = {};
+    int iNumFrames = 0;
+   #if JUCE_MAC || JUCE_LINUX
+    iNumFrames = juce::jmax (0, backtrace (frames, 32 + iSkipFrames) - iSkipFrames);
+   #endif
+    void* const* callSite = frames + iSkipFrames;
+
+    // count repeats of a known call site instead of filling the table every block
+    const int iNum = juce::jmin (iNumViolations.load(), iMaxViolations);
+    for (int i = 0; i < iNum; i++) {
+        if (isSameCallSite (violations[i], type, callSite, iNumFrames)) {
+            violations[i].iCount++;
+            return;
+        }
+    }
+
+    const int iIndex = iNumViolations++;
+    if (iIndex < iMaxViolations)
+    {
+        auto& v = violations[iIndex];
+        v.type = type;
+        v.function = function;
+        v.iNumFrames = iNumFrames;
+        std::memcpy (v.frames, callSite, sizeof (void*) * (size_t) iNumFrames);
+        v.iCount = 1;
+        v.bReady = true;
+    }
+}
+
+void RealtimeSafetyChecker::check (ViolationType type, const char* function) noexcept
+{
+    if (iAudioThreadDepth == 0 || bInsideCheck)
+        return;
+
+    bInsideCheck = true; // backtrace() may itself allocate or lock the first time
+
+    // clearViolations() waits for checks in flight, and new ones stay out while it runs
+    iChecksInFlight++;
+    if (! bClearing.load())
+        record (type, function);
+    iChecksInFlight--;
+
+    bInsideCheck = false;
+}
+
+int RealtimeSafetyChecker::getNumViolations()
+{
+    return juce::jmin (iNumViolations.load(), iMaxViolations);
+}
+
+int RealtimeSafetyChecker::getNumViolations (ViolationType type)
+{
+    int iNum = 0;
+    for (int i = 0; i < getNumViolations(); i++)
+        if (violations[i].bReady.load() && violations[i].type == type)
+            iNum++;
+    return iNum;
+}
+
+juce::String RealtimeSafetyChecker::getViolationReport (int index)
+{
+    static const char* typeNames[] = { "allocation", "deallocation", "lock", "system call" };
+
+    if (index < 0 || index >= getNumViolations())
+        return {};
+
+    auto& v = violations[index];
+    if (! v.bReady.load())
+        return {}; // still being recorded
+
+    juce::String report;
+    report << "Real-time violation: " << typeNames[v.type] << " (" << v.function << ") on the audio thread, "
+           << v.iCount.load() << "x\n";
+
+   #if JUCE_MAC || JUCE_LINUX
+    if (auto** symbols = backtrace_symbols (v.frames, v.iNumFrames)) {
+        for (int f = 0; f < v.iNumFrames; f++)
+            report << "    " << symbols[f] << "\n";
+        std::free (symbols);
+    }
+   #endif
+
+    return report;
+}
+
+juce::StringArray RealtimeSafetyChecker::getViolationReports()
+{
+    juce::StringArray reports;
+
+    for (int i = 0; i < getNumViolations(); i++) {
+        auto report = getViolationReport (i);
+        if (report.isNotEmpty())
+            reports.add (report);
+    }
+
+    return reports;
+}
+
+void RealtimeSafetyChecker::clearViolations()
+{
+    bClearing = true;
+    while (iChecksInFlight.load() > 0)
+        juce::Thread::yield();
+
+    for (auto& v : violations)
+        v.bReady = false;
+    iNumViolations = 0;
+
+    bClearing = false;
+}
+
+//==============================================================================
+// Allocation hooks. The global operators are replaced on every platform;
+// malloc/calloc/realloc/free, which JUCE's containers (Array, HeapBlock,
+// MemoryBlock, AudioBuffer) use directly, are interposed on macOS and Linux
+// further down. Operators report once and then reach malloc with the check
+// suppressed, so each allocation shows up a single time.
+namespace
+{
+    void* allocate (std::size_t size, std::size_t alignment, const char* function) noexcept
+    {
+        RealtimeSafetyChecker::check (RealtimeSafetyChecker::ALLOCATION, function);
+
+        const bool bWasInside = bInsideCheck;
+        bInsideCheck = true;
+        void* ptr = nullptr;
+        if (alignment <= alignof (std::max_align_t))
+            ptr = std::malloc (size > 0 ? size : 1);
+       #if JUCE_WINDOWS
+        else
+            ptr = _aligned_malloc (size > 0 ? size : 1, alignment);
+       #else
+        else if (posix_memalign (&ptr, alignment, size > 0 ? size : 1) != 0)
+            ptr = nullptr;
+       #endif
+        bInsideCheck = bWasInside;
+        return ptr;
+    }
+
+    void deallocate (void* ptr, bool bAligned, const char* function) noexcept
+    {
+        if (ptr == nullptr)
+            return;
+
+        RealtimeSafetyChecker::check (RealtimeSafetyChecker::DEALLOCATION, function);
+
+        const bool bWasInside = bInsideCheck;
+        bInsideCheck = true;
+       #if JUCE_WINDOWS
+        if (bAligned)
+            _aligned_free (ptr);
+        else
+            std::free (ptr);
+       #else
+        juce::ignoreUnused (bAligned);
+        std::free (ptr);
+       #endif
+        bInsideCheck = bWasInside;
+    }
+}
+
+void* operator new (std::size_t size)
+{
+    if (void* ptr = allocate (size, 0, "operator new"))
+        return ptr;
+    throw std::bad_alloc();
+}
+
+void* operator new[] (std::size_t size)
+{
+    if (void* ptr = allocate (size, 0, "operator new[]"))
+        return ptr;
+    throw std::bad_alloc();
+}
+
+void* operator new (std::size_t size, const std::nothrow_t&) noexcept   { return allocate (size, 0, "operator new"); }
+void* operator new[] (std::size_t size, const std::nothrow_t&) noexcept { return allocate (size, 0, "operator new[]"); }
+
+void* operator new (std::size_t size, std::align_val_t alignment)
+{
+    if (void* ptr = allocate (size, (std::size_t) alignment, "operator new"))
+        return ptr;
+    throw std::bad_alloc();
+}
+
+void* operator new[] (std::size_t size, std::align_val_t alignment)
+{
+    if (void* ptr = allocate (size, (std::size_t) alignment, "operator new[]"))
+        return ptr;
+    throw std::bad_alloc();
+}
+
+void* operator new (std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept   { return allocate (size, (std::size_t) alignment, "operator new"); }
+void* operator new[] (std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept { return allocate (size, (std::size_t) alignment, "operator new[]"); }
+
+void operator delete (void* ptr) noexcept                                   { deallocate (ptr, false, "operator delete"); }
+void operator delete[] (void* ptr) noexcept                                 { deallocate (ptr, false, "operator delete[]"); }
+void operator delete (void* ptr, std::size_t) noexcept                      { deallocate (ptr, false, "operator delete"); }
+void operator delete[] (void* ptr, std::size_t) noexcept                    { deallocate (ptr, false, "operator delete[]"); }
+void operator delete (void* ptr, const std::nothrow_t&) noexcept            { deallocate (ptr, false, "operator delete"); }
+void operator delete[] (void* ptr, const std::nothrow_t&) noexcept          { deallocate (ptr, false, "operator delete[]"); }
+void operator delete (void* ptr, std::align_val_t) noexcept                 { deallocate (ptr, true, "operator delete"); }
+void operator delete[] (void* ptr, std::align_val_t) noexcept               { deallocate (ptr, true, "operator delete[]"); }
+void operator delete (void* ptr, std::size_t, std::align_val_t) noexcept    { deallocate (ptr, true, "operator delete"); }
+void operator delete[] (void* ptr, std::size_t, std::align_val_t) noexcept  { deallocate (ptr, true, "operator delete[]"); }
+
+//==============================================================================
+// Lock and system call hooks
+#if JUCE_LINUX
+
+template <typename Fn>
+static Fn getNextSymbol (Fn& fn, const char* name)
+{
+    if (fn == nullptr)
+        fn = reinterpret_cast<Fn> (dlsym (RTLD_NEXT, name));
+    return fn;
+}
+
+// glibc's own entry points, so the malloc hooks need no dlsym (which itself allocates)
+extern "C" void* __libc_malloc (size_t);
+extern "C" void* __libc_calloc (size_t, size_t);
+extern "C" void* __libc_realloc (void*, size_t);
+extern "C" void __libc_free (void*);
+
+// signatures (including exception specs) must match glibc's declarations
+extern "C"
+{
+    void* malloc (size_t size) noexcept
+    {
+        RealtimeSafetyChecker::check (RealtimeSafetyChecker::ALLOCATION, "malloc");
+        return __libc_malloc (size);
+    }
+
+    void* calloc (size_t num, size_t size) noexcept
+    {
+        RealtimeSafetyChecker::check (RealtimeSafetyChecker::ALLOCATION, "calloc");
+        return __libc_calloc (num, size);
+    }
+
+    void* realloc (void* ptr, size_t size) noexcept
+    {
+        RealtimeSafetyChecker::check (RealtimeSafetyChecker::ALLOCATION, "realloc");
+        return __libc_realloc (ptr, size);
+    }
+
+    void free (void* ptr) noexcept
+    {
+        if (ptr != nullptr)
+            RealtimeSafetyChecker::check (RealtimeSafetyChecker::DEALLOCATION, "free");
+        __libc_free (ptr);
+    }
+}
+
+// The remaining hooks are bound to the libc symbol through an asm label, so
+// they don't collide with the headers' declarations, whether those are
+// fortified inlines or redirected to the 64-bit variants by _FILE_OFFSET_BITS.
+// Both spellings are hooked, since either may be linked.
+#define SAMPLEASSIST_HOOK(violation, ret, name, params, args) \
+    extern "C" ret rtHook_##name params __asm__ (#name); \
+    extern "C" ret rtHook_##name params \
+    { \
+        static ret (*next) params = nullptr; \
+        RealtimeSafetyChecker::check (RealtimeSafetyChecker::violation, #name); \
+        return getNextSymbol (next, #name) args; \
+    }
+
+SAMPLEASSIST_HOOK (LOCK, int, pthread_mutex_lock, (pthread_mutex_t* mutex), (mutex))
+
+SAMPLEASSIST_HOOK (SYSTEM_CALL, ssize_t, read, (int fd, void* buf, size_t numBytes), (fd, buf, numBytes))
+SAMPLEASSIST_HOOK (SYSTEM_CALL, ssize_t, write, (int fd, const void* buf, size_t numBytes), (fd, buf, numBytes))
+SAMPLEASSIST_HOOK (SYSTEM_CALL, ssize_t, pwrite, (int fd, const void* buf, size_t numBytes, long offset), (fd, buf, numBytes, offset))
+SAMPLEASSIST_HOOK (SYSTEM_CALL, ssize_t, pwrite64, (int fd, const void* buf, size_t numBytes, juce::int64 offset), (fd, buf, numBytes, offset))
+SAMPLEASSIST_HOOK (SYSTEM_CALL, long, lseek, (int fd, long offset, int whence), (fd, offset, whence))
+SAMPLEASSIST_HOOK (SYSTEM_CALL, juce::int64, lseek64, (int fd, juce::int64 offset, int whence), (fd, offset, whence))
+SAMPLEASSIST_HOOK (SYSTEM_CALL, int, fsync, (int fd), (fd))
+SAMPLEASSIST_HOOK (SYSTEM_CALL, int, close, (int fd), (fd))
+SAMPLEASSIST_HOOK (SYSTEM_CALL, int, unlink, (const char* path), (path))
+SAMPLEASSIST_HOOK (SYSTEM_CALL, int, remove, (const char* path), (path))
+SAMPLEASSIST_HOOK (SYSTEM_CALL, int, rename, (const char* from, const char* to), (from, to))
+SAMPLEASSIST_HOOK (SYSTEM_CALL, int, mkdir, (const char* path, unsigned int mode), (path, mode))
+SAMPLEASSIST_HOOK (SYSTEM_CALL, int, stat, (const char* path, void* info), (path, info))
+SAMPLEASSIST_HOOK (SYSTEM_CALL, int, stat64, (const char* path, void* info), (path, info))
+
+// the mode argument is only present when a file may be created
+static unsigned int getOpenMode (int flags, va_list args)
+{
+   #ifdef O_TMPFILE
+    const bool bHasMode = (flags & O_CREAT) != 0 || (flags & O_TMPFILE) == O_TMPFILE;
+   #else
+    const bool bHasMode = (flags & O_CREAT) != 0;
+   #endif
+    return bHasMode ? va_arg (args, unsigned int) : 0;
+}
+
+#define SAMPLEASSIST_OPEN_HOOK(name) \
+    extern "C" int rtHook_##name (const char* path, int flags, ...) __asm__ (#name); \
+    extern "C" int rtHook_##name (const char* path, int flags, ...) \
+    { \
+        static int (*next) (const char*, int, ...) = nullptr; \
+        va_list args; \
+        va_start (args, flags); \
+        const unsigned int mode = getOpenMode (flags, args); \
+        va_end (args); \
+        RealtimeSafetyChecker::check (RealtimeSafetyChecker::SYSTEM_CALL, #name); \
+        return getNextSymbol (next, #name) (path, flags, mode); \
+    }
+
+#define SAMPLEASSIST_OPENAT_HOOK(name) \
+    extern "C" int rtHook_##name (int dirFd, const char* path, int flags, ...) __asm__ (#name); \
+    extern "C" int rtHook_##name (int dirFd, const char* path, int flags, ...) \
+    { \
+        static int (*next) (int, const char*, int, ...) = nullptr; \
+        va_list args; \
+        va_start (args, flags); \
+        const unsigned int mode = getOpenMode (flags, args); \
+        va_end (args); \
+        RealtimeSafetyChecker::check (RealtimeSafetyChecker::SYSTEM_CALL, #name); \
+        return getNextSymbol (next, #name) (dirFd, path, flags, mode); \
+    }
+
+SAMPLEASSIST_OPEN_HOOK (open)
+SAMPLEASSIST_OPEN_HOOK (open64)
+SAMPLEASSIST_OPENAT_HOOK (openat)
+SAMPLEASSIST_OPENAT_HOOK (openat64)
+
+#elif JUCE_MAC
+
+// dyld routes calls to the originals through these, except calls made from this image's hooks
+#define SAMPLEASSIST_INTERPOSE(replacement, original) \
+    __attribute__((used)) static const struct { const void* r; const void* o; } interpose_##original \
+    __attribute__((section ("__DATA,__interpose"))) = { (const void*) &replacement, (const void*) &original };
+
+static void* checkedMalloc (size_t size)
+{
+    RealtimeSafetyChecker::check (RealtimeSafetyChecker::ALLOCATION, "malloc");
+    return malloc (size);
+}
+
+static void* checkedCalloc (size_t num, size_t size)
+{
+    RealtimeSafetyChecker::check (RealtimeSafetyChecker::ALLOCATION, "calloc");
+    return calloc (num, size);
+}
+
+static void* checkedRealloc (void* ptr, size_t size)
+{
+    RealtimeSafetyChecker::check (RealtimeSafetyChecker::ALLOCATION, "realloc");
+    return realloc (ptr, size);
+}
+
+static void checkedFree (void* ptr)
+{
+    if (ptr != nullptr)
+        RealtimeSafetyChecker::check (RealtimeSafetyChecker::DEALLOCATION, "free");
+    free (ptr);
+}
+
+static int checkedMutexLock (pthread_mutex_t* mutex)
+{
+    RealtimeSafetyChecker::check (RealtimeSafetyChecker::LOCK, "pthread_mutex_lock");
+    return pthread_mutex_lock (mutex);
+}
+
+static ssize_t checkedRead (int fd, void* buf, size_t numBytes)
+{
+    RealtimeSafetyChecker::check (RealtimeSafetyChecker::SYSTEM_CALL, "read");
+    return read (fd, buf, numBytes);
+}
+
+static ssize_t checkedWrite (int fd, const void* buf, size_t numBytes)
+{
+    RealtimeSafetyChecker::check (RealtimeSafetyChecker::SYSTEM_CALL, "write");
+    return write (fd, buf, numBytes);
+}
+
+static ssize_t checkedPwrite (int fd, const void* buf, size_t numBytes, off_t offset)
+{
+    RealtimeSafetyChecker::check (RealtimeSafetyChecker::SYSTEM_CALL, "pwrite");
+    return pwrite (fd, buf, numBytes, offset);
+}
+
+static off_t checkedLseek (int fd, off_t offset, int whence)
+{
+    RealtimeSafetyChecker::check (RealtimeSafetyChecker::SYSTEM_CALL, "lseek");
+    return lseek (fd, offset, whence);
+}
+
+static int checkedFsync (int fd)
+{
+    RealtimeSafetyChecker::check (RealtimeSafetyChecker::SYSTEM_CALL, "fsync");
+    return fsync (fd);
+}
+
+static int checkedClose (int fd)
+{
+    RealtimeSafetyChecker::check (RealtimeSafetyChecker::SYSTEM_CALL, "close");
+    return close (fd);
+}
+
+static int checkedUnlink (const char* path)
+{
+    RealtimeSafetyChecker::check (RealtimeSafetyChecker::SYSTEM_CALL, "unlink");
+    return unlink (path);
+}
+
+static int checkedRemove (const char* path)
+{
+    RealtimeSafetyChecker::check (RealtimeSafetyChecker::SYSTEM_CALL, "remove");
+    return remove (path);
+}
+
+static int checkedRename (const char* from, const char* to)
+{
+    RealtimeSafetyChecker::check (RealtimeSafetyChecker::SYSTEM_CALL, "rename");
+    return rename (from, to);
+}
+
+static int checkedMkdir (const char* path, mode_t mode)
+{
+    RealtimeSafetyChecker::check (RealtimeSafetyChecker::SYSTEM_CALL, "mkdir");
+    return mkdir (path, mode);
+}
+
+static int checkedStat (const char* path, struct stat* info)
+{
+    RealtimeSafetyChecker::check (RealtimeSafetyChecker::SYSTEM_CALL, "stat");
+    return stat (path, info);
+}
+
+// the mode argument is only present when a file may be created
+static int getOpenMode (int flags, va_list args)
+{
+    return (flags & O_CREAT) != 0 ? va_arg (args, int) : 0;
+}
+
+static int checkedOpen (const char* path, int flags, ...)
+{
+    va_list args;
+    va_start (args, flags);
+    const int mode = getOpenMode (flags, args);
+    va_end (args);
+
+    RealtimeSafetyChecker::check (RealtimeSafetyChecker::SYSTEM_CALL, "open");
+    return open (path, flags, mode);
+}
+
+static int checkedOpenat (int dirFd, const char* path, int flags, ...)
+{
+    va_list args;
+    va_start (args, flags);
+    const int mode = getOpenMode (flags, args);
+    va_end (args);
+
+    RealtimeSafetyChecker::check (RealtimeSafetyChecker::SYSTEM_CALL, "openat");
+    return openat (dirFd, path, flags, mode);
+}
+
+SAMPLEASSIST_INTERPOSE (checkedMalloc, malloc)
+SAMPLEASSIST_INTERPOSE (checkedCalloc, calloc)
+SAMPLEASSIST_INTERPOSE (checkedRealloc, realloc)
+SAMPLEASSIST_INTERPOSE (checkedFree, free)
+SAMPLEASSIST_INTERPOSE (checkedMutexLock, pthread_mutex_lock)
+SAMPLEASSIST_INTERPOSE (checkedRead, read)
+SAMPLEASSIST_INTERPOSE (checkedWrite, write)
+SAMPLEASSIST_INTERPOSE (checkedPwrite, pwrite)
+SAMPLEASSIST_INTERPOSE (checkedLseek, lseek)
+SAMPLEASSIST_INTERPOSE (checkedFsync, fsync)
+SAMPLEASSIST_INTERPOSE (checkedClose, close)
+SAMPLEASSIST_INTERPOSE (checkedUnlink, unlink)
+SAMPLEASSIST_INTERPOSE (checkedRemove, remove)
+SAMPLEASSIST_INTERPOSE (checkedRename, rename)
+SAMPLEASSIST_INTERPOSE (checkedMkdir, mkdir)
+SAMPLEASSIST_INTERPOSE (checkedStat, stat)
+SAMPLEASSIST_INTERPOSE (checkedOpen, open)
+SAMPLEASSIST_INTERPOSE (checkedOpenat, openat)
+
+#endif
+
+#else
+
+//==============================================================================
+void RealtimeSafetyChecker::check (ViolationType, const char*) noexcept {}
+int RealtimeSafetyChecker::getNumViolations() { return 0; }
+int RealtimeSafetyChecker::getNumViolations (ViolationType) { return 0; }
+juce::String RealtimeSafetyChecker::getViolationReport (int) { return {}; }
+juce::StringArray RealtimeSafetyChecker::getViolationReports() { return {}; }
+void RealtimeSafetyChecker::clearViolations() {}
+
+#endif
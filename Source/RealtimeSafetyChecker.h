@@ -0,0 +1,78 @@
+/*
+  ==============================================================================
+
+    RealtimeSafetyChecker.h
+    Created: 19 Oct 2026
+    Author:  Patrick Gammack
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+// Enabled in the Debug configuration of the .jucer. When off, everything
+// below compiles down to nothing.
+#ifndef SAMPLEASSIST_RT_CHECKS
+ #define SAMPLEASSIST_RT_CHECKS 0
+#endif
+
+//==============================================================================
+/**
+    Catches work that is not real-time safe on the audio thread.
+
+    Put a ScopedAudioThread at the top of processBlock. While it is in scope,
+    heap allocations, mutex locks and blocking file system calls made on that
+    thread are recorded, with a stack trace, into a fixed table. Recording
+    does not allocate or lock. Read the table from another thread with
+    getViolationReport().
+
+    operator new/delete are replaced everywhere. malloc/calloc/realloc/free,
+    locks and system calls are intercepted by symbol interposition, which
+    works on macOS and Linux in Standalone builds and test executables. Hosts
+    that load the plugin privately may only see operator new/delete.
+*/
+
+class RealtimeSafetyChecker
+{
+public:
+    enum ViolationType {
+        ALLOCATION,
+        DEALLOCATION,
+        LOCK,
+        SYSTEM_CALL,
+    };
+
+    class ScopedAudioThread
+    {
+    public:
+       #if SAMPLEASSIST_RT_CHECKS
+        ScopedAudioThread();
+        ~ScopedAudioThread();
+       #else
+        ScopedAudioThread() {}
+        ~ScopedAudioThread() {}
+       #endif
+
+        JUCE_DECLARE_NON_COPYABLE (ScopedAudioThread)
+    };
+
+    // called by the hooks; does nothing unless the caller is inside a ScopedAudioThread
+    static void check (ViolationType type, const char* function) noexcept;
+
+    // one entry per distinct call site, in the order they were first hit;
+    // entries are never reordered, so a reader can poll for new ones by index
+    static int getNumViolations();
+    static int getNumViolations (ViolationType type);
+    // symbolised stack trace, or empty while the entry is still being recorded
+    static juce::String getViolationReport (int index);
+    static juce::StringArray getViolationReports();
+    // safe while the audio thread is running, but must not race the readers above
+    static void clearViolations();
+
+private:
+   #if SAMPLEASSIST_RT_CHECKS
+    static void record (ViolationType type, const char* function) noexcept;
+   #endif
+};
@@ -0,0 +1,124 @@
+/*
+  ==============================================================================
+
+    RealtimeSafetyTests.cpp
+    Created: 19 Oct 2026
+    Author:  Patrick Gammack
+
+  ==============================================================================
+*/
+
+#include "PluginProcessor.h"
+
+// Only meaningful where the checker can see malloc and system calls
+#if SAMPLEASSIST_RT_CHECKS && (JUCE_MAC || JUCE_LINUX)
+
+//==============================================================================
+/**
+    Drives processBlock through arm -> count-down -> record and checks that
+    the audio thread never allocates or touches the file system, and takes
+    no lock but writerLock. Run with "SampleAssist --run-tests".
+*/
+
+class RealtimeSafetyTests : public juce::UnitTest
+{
+public:
+    RealtimeSafetyTests() : juce::UnitTest ("Real-time safety", "SampleAssist") {}
+
+    void runTest() override
+    {
+        using Checker = RealtimeSafetyChecker;
+
+        beginTest ("Only work inside the audio thread scope is reported");
+        {
+            Checker::clearViolations();
+            juce::HeapBlock<float> outside (256);
+            expectEquals (Checker::getNumViolations(), 0);
+
+            {
+                Checker::ScopedAudioThread scope;
+                juce::HeapBlock<float> inside (256);
+                juce::File::getSpecialLocation (juce::File::tempDirectory).exists();
+            }
+            expect (Checker::getNumViolations (Checker::ALLOCATION) > 0, "malloc not reported");
+            expect (Checker::getNumViolations (Checker::DEALLOCATION) > 0, "free not reported");
+            expect (Checker::getNumViolations (Checker::SYSTEM_CALL) > 0, "stat not reported");
+        }
+
+        auto directory = juce::File::getSpecialLocation (juce::File::tempDirectory)
+                            .getNonexistentChildFile ("SampleAssistRealtimeTest", {});
+        directory.createDirectory();
+
+        {
+            AutoSamplerAudioProcessor processor;
+            processor.setSampleDirectory (directory.getFullPathName());
+            processor.setRateAndBufferSizeDetails (dSampleRate, iBlockSize);
+            processor.prepareToPlay (dSampleRate, iBlockSize);
+
+            juce::AudioBuffer<float> buffer (2, iBlockSize);
+            juce::MidiBuffer midi;
+
+            beginTest ("Counting down and starting a take leave the file work to armRecording");
+            {
+                processor.armRecording();
+                Checker::clearViolations();
+
+                // the count-down runs for 4 seconds, recording starts with 500ms to go
+                for (int i = 0; i < (int) (dSampleRate * 4) / iBlockSize && ! processor.isRecording(); i++)
+                    render (processor, buffer, midi);
+
+                expect (processor.isRecording(), "recording never started");
+                expectEquals (Checker::getNumViolations (Checker::ALLOCATION), 0);
+                expectEquals (Checker::getNumViolations (Checker::DEALLOCATION), 0);
+                expectEquals (Checker::getNumViolations (Checker::SYSTEM_CALL), 0);
+                // writerLock, taken by startRecording() and by processBlock
+                expectEquals (Checker::getNumViolations (Checker::LOCK), 2, "unexpected lock on the audio thread");
+
+                if (Checker::getNumViolations() != 2)
+                    logMessage (Checker::getViolationReports().joinIntoString ("\n"));
+            }
+
+            beginTest ("A running take neither allocates, touches the file system nor takes new locks");
+            {
+                Checker::clearViolations();
+
+                for (int i = 0; i < (int) dSampleRate / iBlockSize; i++)
+                    render (processor, buffer, midi);
+
+                expectEquals (Checker::getNumViolations (Checker::ALLOCATION), 0);
+                expectEquals (Checker::getNumViolations (Checker::DEALLOCATION), 0);
+                expectEquals (Checker::getNumViolations (Checker::SYSTEM_CALL), 0);
+                // the only known lock is processBlock's writerLock; any other call site fails
+                expectEquals (Checker::getNumViolations (Checker::LOCK), 1, "unexpected lock on the audio thread");
+
+                if (Checker::getNumViolations() != 1)
+                    logMessage (Checker::getViolationReports().joinIntoString ("\n"));
+            }
+
+            processor.stopRecording();
+            processor.releaseResources();
+        }
+
+        Checker::clearViolations();
+        directory.deleteRecursively();
+    }
+
+private:
+    void render (AutoSamplerAudioProcessor& processor, juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midi)
+    {
+        for (int ch = 0; ch < buffer.getNumChannels(); ch++)
+            for (int i = 0; i < buffer.getNumSamples(); i++)
+                buffer.setSample (ch, i, 0.25f * std::sin (dPhase + 0.05 * i));
+        dPhase += 0.05 * buffer.getNumSamples();
+
+        processor.processBlock (buffer, midi);
+    }
+
+    static constexpr double dSampleRate = 48000.0;
+    static constexpr int iBlockSize = 512;
+    double dPhase = 0;
+};
+
+static RealtimeSafetyTests realtimeSafetyTests;
+
+#endif
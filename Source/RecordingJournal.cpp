@@ -0,0 +1,261 @@
+/*
+  ==============================================================================
+
+    RecordingJournal.cpp
+    Created: 19 Oct 2026
+    Author:  Patrick Gammack
+
+  ==============================================================================
+*/
+
+#include "RecordingJournal.h"
+
+static const char beginEntry = 'B';
+static const char endEntry = 'E';
+
+// files with an unfinished take in this process, across all instances;
+// recovery must never repair a file a writer still has open
+namespace
+{
+    struct ActiveTakes
+    {
+        juce::CriticalSection lock;
+        juce::Array<juce::File> files;
+    };
+
+    ActiveTakes& getActiveTakes()
+    {
+        static ActiveTakes activeTakes;
+        return activeTakes;
+    }
+
+    bool isTakeActive (const juce::File& file)
+    {
+        auto& active = getActiveTakes();
+        const juce::ScopedLock sl (active.lock);
+        return active.files.contains (file);
+    }
+}
+
+//==============================================================================
+RecordingJournal::RecordingJournal()
+{
+}
+
+RecordingJournal::~RecordingJournal()
+{
+    setActiveFile ({});
+    close();
+}
+
+juce::Array<RecordingJournal::RecoveredTake> RecordingJournal::open (const juce::File& directory)
+{
+    // switching journals mid-take would lose its end entry
+    if (activeFile != juce::File{}) {
+        jassertfalse;
+        return {};
+    }
+
+    close();
+    journalFile = directory.getChildFile ("recording.journal");
+
+    auto recovered = recover();
+
+    const juce::ScopedLock sl (streamLock);
+    journalFile.deleteFile();
+    stream = std::make_unique<juce::FileOutputStream> (journalFile);
+    if (stream->failedToOpen())
+        stream.reset();
+
+    return recovered;
+}
+
+void RecordingJournal::close()
+{
+    const juce::ScopedLock sl (streamLock);
+    stream.reset();
+}
+
+void RecordingJournal::beginTake (int slot, const juce::File& file)
+{
+    setActiveFile (file);
+
+    const juce::ScopedLock sl (streamLock);
+    if (stream == nullptr)
+        return;
+
+    stream->writeByte (beginEntry);
+    stream->writeInt (slot);
+    stream->writeString (file.getFullPathName());
+    stream->flush();
+}
+
+void RecordingJournal::endTake (int slot)
+{
+    setActiveFile ({});
+
+    const juce::ScopedLock sl (streamLock);
+    if (stream == nullptr)
+        return;
+
+    stream->writeByte (endEntry);
+    stream->writeInt (slot);
+    stream->flush();
+}
+
+void RecordingJournal::setActiveFile (const juce::File& file)
+{
+    auto& active = getActiveTakes();
+    const juce::ScopedLock sl (active.lock);
+
+    active.files.removeFirstMatchingValue (activeFile);
+    activeFile = file;
+    if (activeFile != juce::File{})
+        active.files.add (activeFile);
+}
+
+juce::Array<RecordingJournal::RecoveredTake> RecordingJournal::recover()
+{
+    juce::Array<RecoveredTake> recovered;
+
+    juce::FileInputStream input (journalFile);
+    if (input.failedToOpen())
+        return recovered;
+
+    // replay the log; whatever is still open at the end was interrupted
+    std::map<int, juce::File> openTakes;
+
+    while (! input.isExhausted())
+    {
+        const char type = input.readByte();
+        const int iSlot = input.readInt();
+
+        if (type == beginEntry) {
+            auto path = input.readString();
+            if (juce::File::isAbsolutePath (path))
+                openTakes[iSlot] = juce::File (path);
+        }
+        else if (type == endEntry)
+            openTakes.erase (iSlot);
+        else
+            break; // torn write at the tail
+    }
+
+    for (auto& take : openTakes)
+    {
+        if (isTakeActive (take.second))
+            continue; // still being written, by this or another instance
+
+        double dSampleRate = 0;
+        const auto iLength = repairWavFile (take.second, &dSampleRate);
+        if (iLength >= 0)
+            recovered.add ({ take.first, take.second, iLength, dSampleRate });
+    }
+
+    return recovered;
+}
+
+//==============================================================================
+juce::int64 RecordingJournal::repairWavFile (const juce::File& file, double* sampleRate)
+{
+    const juce::int64 iFileSize = file.getSize();
+
+    juce::int64 iDataStart = -1, iDataSizePos = -1, iDs64Pos = -1;
+    int iBlockAlign = 0;
+    int iSampleRate = 0;
+    bool bIsRF64 = false;
+
+    {
+        juce::FileInputStream input (file);
+        if (input.failedToOpen())
+            return -1;
+
+        const int iRiff = input.readInt();
+        input.readInt();
+        if ((iRiff != (int) juce::ByteOrder::littleEndianInt ("RIFF") && iRiff != (int) juce::ByteOrder::littleEndianInt ("RF64"))
+            || input.readInt() != (int) juce::ByteOrder::littleEndianInt ("WAVE"))
+            return -1;
+
+        bIsRF64 = (iRiff == (int) juce::ByteOrder::littleEndianInt ("RF64"));
+
+        // walk the header chunks up to "data"; everything before it was written complete
+        while (input.getPosition() + 8 <= iFileSize)
+        {
+            const juce::int64 iChunkPos = input.getPosition();
+            const int iChunkType = input.readInt();
+            const juce::int64 iChunkSize = (juce::uint32) input.readInt();
+
+            if (iChunkType == (int) juce::ByteOrder::littleEndianInt ("data")) {
+                iDataSizePos = iChunkPos + 4;
+                iDataStart = iChunkPos + 8;
+                break;
+            }
+
+            if (iChunkType == (int) juce::ByteOrder::littleEndianInt ("fmt ")) {
+                input.skipNextBytes (4); // format, channels
+                iSampleRate = input.readInt();
+                input.skipNextBytes (4); // byte rate
+                iBlockAlign = (juce::uint16) input.readShort();
+            }
+            else if (iChunkType == (int) juce::ByteOrder::littleEndianInt ("ds64")
+                     || (iChunkType == (int) juce::ByteOrder::littleEndianInt ("JUNK") && iChunkSize >= 28))
+                iDs64Pos = iChunkPos; // JUCE reserves a JUNK chunk to become ds64 if needed
+
+            if (! input.setPosition (iChunkPos + 8 + iChunkSize + (iChunkSize & 1)))
+                return -1;
+        }
+    }
+
+    if (iDataStart < 0 || iBlockAlign <= 0)
+        return -1;
+
+    if (sampleRate != nullptr)
+        *sampleRate = iSampleRate;
+
+    // drop any partially written frame at the tail
+    const juce::int64 iDataBytes = (iFileSize - iDataStart) / iBlockAlign * iBlockAlign;
+    const juce::int64 iRiffSize = iDataStart - 8 + iDataBytes;
+    const bool bNeeds64Bit = iRiffSize > (juce::int64) 0xffffffff;
+
+    if ((bNeeds64Bit || bIsRF64) && iDs64Pos < 0)
+        return -1;
+
+    juce::FileOutputStream output (file);
+    if (output.failedToOpen())
+        return -1;
+
+    if (bNeeds64Bit && ! bIsRF64)
+    {
+        output.setPosition (0);
+        output.write ("RF64", 4);
+        output.setPosition (iDs64Pos);
+        output.write ("ds64", 4);
+        bIsRF64 = true;
+    }
+
+    if (bIsRF64)
+    {
+        // 32-bit fields are set to -1 and the real sizes go into ds64
+        output.setPosition (4);
+        output.writeInt (-1);
+        output.setPosition (iDataSizePos);
+        output.writeInt (-1);
+        output.setPosition (iDs64Pos + 8);
+        output.writeInt64 (iRiffSize);
+        output.writeInt64 (iDataBytes);
+        output.writeInt64 (iDataBytes / iBlockAlign);
+    }
+    else
+    {
+        output.setPosition (4);
+        output.writeInt ((int) (juce::uint32) iRiffSize);
+        output.setPosition (iDataSizePos);
+        output.writeInt ((int) (juce::uint32) iDataBytes);
+    }
+
+    output.setPosition (iDataStart + iDataBytes);
+    output.truncate();
+    output.flush();
+
+    return iDataBytes / iBlockAlign;
+}
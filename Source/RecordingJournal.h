@@ -0,0 +1,64 @@
+/*
+  ==============================================================================
+
+    RecordingJournal.h
+    Created: 19 Oct 2026
+    Author:  Patrick Gammack
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+//==============================================================================
+/**
+    Small append-only log of take boundaries, kept next to the samples. Every
+    take writes a begin entry when it is armed and an end entry once its file
+    has been closed cleanly, or the take was cancelled.
+
+    On the next launch, a begin with no matching end marks a take that was
+    interrupted. recover() repairs those files from their header and size on
+    disk alone, without reading the audio.
+*/
+
+class RecordingJournal
+{
+public:
+    struct RecoveredTake
+    {
+        int iSlot;
+        juce::File file;
+        juce::int64 iLengthSamples;
+        double dSampleRate;
+    };
+
+    RecordingJournal();
+    ~RecordingJournal();
+
+    // repairs anything left unfinished in directory's journal, then starts a fresh one;
+    // does nothing while a take is between beginTake() and endTake()
+    juce::Array<RecoveredTake> open (const juce::File& directory);
+    void close();
+
+    // these write and flush the journal, so keep them off the audio thread
+    void beginTake (int slot, const juce::File& file);
+    void endTake (int slot);
+
+    // fixes the RIFF/RF64 and data sizes of a WAV whose writer never finished;
+    // returns the recovered length in samples, or -1 if the file isn't usable,
+    // and fills in sampleRate from the fmt chunk if given
+    static juce::int64 repairWavFile (const juce::File& file, double* sampleRate = nullptr);
+
+private:
+    juce::Array<RecoveredTake> recover();
+    void setActiveFile (const juce::File& file);
+
+    juce::File journalFile;
+    juce::File activeFile;
+    juce::CriticalSection streamLock;
+    std::unique_ptr<juce::FileOutputStream> stream;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (RecordingJournal)
+};
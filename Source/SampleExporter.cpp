@@ -0,0 +1,349 @@
+/*
+  ==============================================================================
+
+    SampleExporter.cpp
+    Created: 19 Oct 2026
+    Author:  Patrick Gammack
+
+  ==============================================================================
+*/
+
+#include "SampleExporter.h"
+
+static double besselI0 (double x)
+{
+    double sum = 1.0, term = 1.0;
+    for (int k = 1; k < 32; k++) {
+        term *= (x / (2.0 * k)) * (x / (2.0 * k));
+        sum += term;
+    }
+    return sum;
+}
+
+//==============================================================================
+PolyphaseResampler::PolyphaseResampler (double sourceRate, double targetRate, int numChannels)
+{
+    iNumChannels = numChannels;
+    dStep = sourceRate / targetRate;
+    iTotalIn = 0;
+    iTotalOut = 0;
+
+    // 96 taps at the lower of the two rates gives a transition band of about
+    // 8% of that rate (20k-24.1k at 44.1k) with ~115 dB stopband rejection;
+    // widen the filter when downsampling so the transition band stays the same
+    iNumTaps = 96 * juce::jmax (1, (int) std::ceil (dStep));
+
+    const double dCutoff = 0.5 * juce::jmin (1.0, 1.0 / dStep); // cycles per input sample, centre of the transition band
+    const double dBeta = 12.0;
+    const double dHalfWidth = iNumTaps * 0.5;
+
+    taps.resize ((size_t) ((iNumPhases + 1) * iNumTaps));
+
+    for (int p = 0; p <= iNumPhases; p++)
+    {
+        float* phase = taps.data() + p * iNumTaps;
+        double dSum = 0.0;
+
+        for (int k = 0; k < iNumTaps; k++)
+        {
+            // distance of this tap from the output instant, in input samples
+            const double d = k - iNumTaps / 2 + 1 - (double) p / iNumPhases;
+            const double x = 2.0 * dCutoff * d;
+            const double sinc = d == 0.0 ? 1.0 : std::sin (juce::MathConstants<double>::pi * x) / (juce::MathConstants<double>::pi * x);
+            const double r = d / dHalfWidth;
+            const double window = std::abs (r) < 1.0 ? besselI0 (dBeta * std::sqrt (1.0 - r * r)) / besselI0 (dBeta) : 0.0;
+
+            phase[k] = (float) (2.0 * dCutoff * sinc * window);
+            dSum += phase[k];
+        }
+
+        for (int k = 0; k < iNumTaps; k++) // unity gain at DC
+            phase[k] = (float) (phase[k] / dSum);
+    }
+
+    // pre-pad so the first window is centred on the first input sample
+    history.resize ((size_t) iNumChannels);
+    for (auto& h : history)
+        h.assign ((size_t) (iNumTaps / 2), 0.0f);
+    dPosition = iNumTaps / 2;
+}
+
+int PolyphaseResampler::getMaxOutputSamples (int numInputSamples) const
+{
+    return (int) std::ceil ((numInputSamples + iNumTaps) / dStep) + 2;
+}
+
+int PolyphaseResampler::process (const float* const* input, int numInputSamples, juce::AudioBuffer<float>& output)
+{
+    for (int c = 0; c < iNumChannels; c++)
+        history[(size_t) c].insert (history[(size_t) c].end(), input[c], input[c] + numInputSamples);
+
+    iTotalIn += numInputSamples;
+    return render (output, std::numeric_limits<juce::int64>::max());
+}
+
+int PolyphaseResampler::flush (juce::AudioBuffer<float>& output)
+{
+    for (auto& h : history)
+        h.insert (h.end(), (size_t) iNumTaps, 0.0f);
+
+    return render (output, (juce::int64) std::ceil (iTotalIn / dStep));
+}
+
+int PolyphaseResampler::render (juce::AudioBuffer<float>& output, juce::int64 iLimit)
+{
+    const int iSize = (int) history[0].size();
+    const int iMaxOut = output.getNumSamples();
+    int iOut = 0;
+
+    while (iTotalOut < iLimit && iOut < iMaxOut)
+    {
+        const int iStart = (int) dPosition - iNumTaps / 2 + 1;
+        if (iStart + iNumTaps > iSize)
+            break;
+
+        // interpolate linearly between the two nearest phases of the table
+        const double dPhase = (dPosition - std::floor (dPosition)) * iNumPhases;
+        const int iPhase = juce::jmin ((int) dPhase, iNumPhases - 1);
+        const float fFrac = (float) (dPhase - iPhase);
+        const float* phase = taps.data() + iPhase * iNumTaps;
+        const float* next = phase + iNumTaps;
+
+        for (int c = 0; c < iNumChannels; c++)
+        {
+            const float* x = history[(size_t) c].data() + iStart;
+
+            // four independent accumulators so the loop maps onto vector registers
+            float s0 = 0.0f, s1 = 0.0f, s2 = 0.0f, s3 = 0.0f;
+            for (int k = 0; k < iNumTaps; k += 4) {
+                s0 += (phase[k]     + fFrac * (next[k]     - phase[k]))     * x[k];
+                s1 += (phase[k + 1] + fFrac * (next[k + 1] - phase[k + 1])) * x[k + 1];
+                s2 += (phase[k + 2] + fFrac * (next[k + 2] - phase[k + 2])) * x[k + 2];
+                s3 += (phase[k + 3] + fFrac * (next[k + 3] - phase[k + 3])) * x[k + 3];
+            }
+            output.getWritePointer (c)[iOut] = (s0 + s1) + (s2 + s3);
+        }
+
+        iOut++;
+        iTotalOut++;
+        dPosition += dStep;
+    }
+
+    // drop input that no future window can reach
+    const int iConsumed = juce::jlimit (0, iSize, (int) dPosition - iNumTaps / 2 + 1);
+    for (auto& h : history)
+        h.erase (h.begin(), h.begin() + iConsumed);
+    dPosition -= iConsumed;
+
+    return iOut;
+}
+
+//==============================================================================
+juce::String ExportTarget::getFolderName() const
+{
+    // e.g. 44100/24 -> "44k1_24bit", 48000/16 -> "48k_16bit"
+    const int iKilo = (int) (sampleRate / 1000.0);
+    const int iFraction = juce::roundToInt (std::fmod (sampleRate, 1000.0) / 100.0);
+
+    return juce::String (iKilo) + "k" + (iFraction > 0 ? juce::String (iFraction) : juce::String())
+         + "_" + juce::String (bitDepth) + "bit";
+}
+
+//==============================================================================
+class SampleExporter::ExportJob : public juce::ThreadPoolJob
+{
+public:
+    ExportJob (SampleExporter& o, const juce::File& src, const juce::File& dest, const juce::Array<ExportTarget>& t)
+        : juce::ThreadPoolJob ("Export " + src.getFileName()), owner (o), source (src), destination (dest), targets (t)
+    {
+    }
+
+    JobStatus runJob() override
+    {
+        std::unique_ptr<juce::AudioFormatReader> reader (owner.formatManager.createReaderFor (source));
+        if (reader == nullptr) {
+            owner.addFailure (source.getFileName() + ": can't be read");
+            return jobHasFinished;
+        }
+
+        const int iNumChannels = (int) reader->numChannels;
+        const int iBlockSize = 8192;
+
+        juce::OwnedArray<Output> outputs;
+        for (auto& target : targets)
+        {
+            auto file = destination.getChildFile (target.getFolderName()).getChildFile (source.getFileName());
+            file.getParentDirectory().createDirectory();
+            file.deleteFile();
+
+            if (auto outputStream = std::unique_ptr<juce::FileOutputStream> (file.createOutputStream()))
+            {
+                juce::WavAudioFormat wavFormat;
+
+                if (auto writer = wavFormat.createWriterFor (outputStream.get(), target.sampleRate, (unsigned int) iNumChannels, target.bitDepth, {}, 0))
+                {
+                    outputStream.release();
+                    auto* output = outputs.add (new Output());
+                    output->file = file;
+                    output->writer.reset (writer);
+
+                    // TPDF dither of +/-1 LSB below 24 bit, where truncation distortion is audible
+                    if (target.bitDepth < 24)
+                        output->fDitherLsb = 1.0f / (float) (1 << (target.bitDepth - 1));
+
+                    if (target.sampleRate != reader->sampleRate) {
+                        output->resampler = std::make_unique<PolyphaseResampler> (reader->sampleRate, target.sampleRate, iNumChannels);
+                        output->buffer.setSize (iNumChannels, output->resampler->getMaxOutputSamples (iBlockSize));
+                    }
+                    else if (output->fDitherLsb > 0.0f)
+                        output->buffer.setSize (iNumChannels, iBlockSize);
+
+                    continue;
+                }
+            }
+
+            owner.addFailure (target.getFolderName() + "/" + source.getFileName() + ": can't be created");
+        }
+
+        // a single pass over the source feeds every target
+        juce::AudioBuffer<float> buffer (iNumChannels, iBlockSize);
+
+        for (juce::int64 iPos = 0; iPos < reader->lengthInSamples; iPos += iBlockSize)
+        {
+            if (shouldExit()) {
+                for (auto* output : outputs) {
+                    output->writer.reset();
+                    output->file.deleteFile();
+                }
+                return jobHasFinished;
+            }
+
+            const int iNum = (int) juce::jmin ((juce::int64) iBlockSize, reader->lengthInSamples - iPos);
+            if (! reader->read (&buffer, 0, iNum, iPos, true, true)) {
+                owner.addFailure (source.getFileName() + ": read failed");
+                for (auto* output : outputs) {
+                    output->writer.reset();
+                    output->file.deleteFile();
+                }
+                return jobHasFinished;
+            }
+
+            for (auto* output : outputs)
+            {
+                if (output->resampler != nullptr) {
+                    const int iNumOut = output->resampler->process (buffer.getArrayOfReadPointers(), iNum, output->buffer);
+                    write (*output, output->buffer, iNumOut);
+                }
+                else
+                    write (*output, buffer, iNum);
+            }
+        }
+
+        for (auto* output : outputs)
+        {
+            if (output->resampler != nullptr) {
+                const int iNumOut = output->resampler->flush (output->buffer);
+                write (*output, output->buffer, iNumOut);
+            }
+            output->writer.reset(); // finalises the header
+
+            // a truncated export is worse than none
+            if (output->bFailed) {
+                output->file.deleteFile();
+                owner.addFailure (output->file.getParentDirectory().getFileName() + "/" + output->file.getFileName() + ": write failed");
+            }
+        }
+
+        return jobHasFinished;
+    }
+
+private:
+    struct Output
+    {
+        juce::File file;
+        std::unique_ptr<juce::AudioFormatWriter> writer;
+        std::unique_ptr<PolyphaseResampler> resampler;
+        juce::AudioBuffer<float> buffer; // resampled and/or dithered block
+        float fDitherLsb = 0.0f;
+        juce::Random random;
+        bool bFailed = false;
+    };
+
+    void write (Output& output, const juce::AudioBuffer<float>& block, int numSamples)
+    {
+        if (output.bFailed || numSamples <= 0)
+            return;
+
+        if (output.fDitherLsb > 0.0f)
+        {
+            if (&block != &output.buffer)
+                for (int ch = 0; ch < block.getNumChannels(); ch++)
+                    output.buffer.copyFrom (ch, 0, block, ch, 0, numSamples);
+
+            for (int ch = 0; ch < output.buffer.getNumChannels(); ch++) {
+                auto* data = output.buffer.getWritePointer (ch);
+                for (int i = 0; i < numSamples; i++)
+                    data[i] += (output.random.nextFloat() - output.random.nextFloat()) * output.fDitherLsb;
+            }
+        }
+
+        const auto& source = output.fDitherLsb > 0.0f ? output.buffer : block;
+        if (! output.writer->writeFromAudioSampleBuffer (source, 0, numSamples))
+            output.bFailed = true; // e.g. disk full; stop feeding it
+    }
+
+    SampleExporter& owner;
+    juce::File source;
+    juce::File destination;
+    juce::Array<ExportTarget> targets;
+};
+
+//==============================================================================
+SampleExporter::SampleExporter()
+    : pool (juce::jmax (1, juce::SystemStats::getNumCpus()))
+{
+    formatManager.registerBasicFormats();
+}
+
+SampleExporter::~SampleExporter()
+{
+    cancel();
+}
+
+void SampleExporter::exportFiles (const juce::Array<juce::File>& sources, const juce::File& destination, const juce::Array<ExportTarget>& targets)
+{
+    if (! isExporting()) {
+        const juce::ScopedLock sl (failureLock);
+        failures.clear();
+    }
+
+    for (auto& source : sources)
+        pool.addJob (new ExportJob (*this, source, destination, targets), true);
+}
+
+void SampleExporter::cancel()
+{
+    pool.removeAllJobs (true, 10000);
+}
+
+bool SampleExporter::isExporting() const
+{
+    return pool.getNumJobs() > 0;
+}
+
+int SampleExporter::getNumFilesRemaining() const
+{
+    return pool.getNumJobs();
+}
+
+juce::StringArray SampleExporter::getFailures() const
+{
+    const juce::ScopedLock sl (failureLock);
+    return failures;
+}
+
+void SampleExporter::addFailure (const juce::String& message)
+{
+    const juce::ScopedLock sl (failureLock);
+    failures.add (message);
+}
@@ -0,0 +1,100 @@
+/*
+  ==============================================================================
+
+    SampleExporter.h
+    Created: 19 Oct 2026
+    Author:  Patrick Gammack
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+//==============================================================================
+/**
+    Streaming windowed-sinc resampler for arbitrary rate pairs.
+
+    The filter is held as a table of phases, and each output sample is one
+    contiguous dot product per channel with taps interpolated linearly
+    between the two nearest phases.
+*/
+
+class PolyphaseResampler
+{
+public:
+    PolyphaseResampler (double sourceRate, double targetRate, int numChannels);
+    ~PolyphaseResampler() {}
+
+    // returns the number of samples written to the start of output
+    int process (const float* const* input, int numInputSamples, juce::AudioBuffer<float>& output);
+    int flush (juce::AudioBuffer<float>& output);
+
+    int getMaxOutputSamples (int numInputSamples) const;
+
+private:
+    int render (juce::AudioBuffer<float>& output, juce::int64 iLimit);
+
+    static constexpr int iNumPhases = 1024;
+
+    int iNumChannels;
+    int iNumTaps;
+    double dStep; // input samples per output sample
+    double dPosition;
+    juce::int64 iTotalIn;
+    juce::int64 iTotalOut;
+
+    std::vector<float> taps; // (iNumPhases + 1) rows of iNumTaps
+    std::vector<std::vector<float>> history;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (PolyphaseResampler)
+};
+
+//==============================================================================
+/**
+*/
+
+struct ExportTarget
+{
+    double sampleRate;
+    int bitDepth;
+
+    juce::String getFolderName() const;
+};
+
+//==============================================================================
+/**
+    Converts recorded files to several sample rates and bit depths. Every file
+    is read once and fed to all targets, and files are spread across a pool
+    of worker threads. Targets below 24 bit are TPDF dithered.
+*/
+
+class SampleExporter
+{
+public:
+    SampleExporter();
+    ~SampleExporter();
+
+    void exportFiles (const juce::Array<juce::File>& sources, const juce::File& destination, const juce::Array<ExportTarget>& targets);
+    void cancel();
+
+    bool isExporting() const;
+    int getNumFilesRemaining() const;
+
+    // one line per source or output that didn't export, since the last exportFiles()
+    // started on an idle exporter; failed outputs are deleted rather than left truncated
+    juce::StringArray getFailures() const;
+
+private:
+    class ExportJob;
+
+    void addFailure (const juce::String& message);
+
+    juce::AudioFormatManager formatManager;
+    juce::CriticalSection failureLock;
+    juce::StringArray failures;
+    juce::ThreadPool pool; // last, so its jobs are gone before the members they use
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SampleExporter)
+};
@@ -0,0 +1,167 @@
+/*
+  ==============================================================================
+
+    TakeBrowser.cpp
+    Created: 19 Oct 2026
+    Author:  Patrick Gammack
+
+  ==============================================================================
+*/
+
+#include "TakeBrowser.h"
+
+//==============================================================================
+class TakeBrowser::TakeRow :
+public juce::Component,
+private juce::ChangeListener
+{
+public:
+    TakeRow (TakeBrowser& b)
+        : browser (b), thumbnail (512, b.formatManager, b.thumbnailCache)
+    {
+        setInterceptsMouseClicks (false, false); // let the ListBox handle selection
+        thumbnail.addChangeListener (this);
+    }
+    ~TakeRow() override
+    {
+        thumbnail.removeChangeListener (this);
+    }
+
+    void update (const juce::File& file, bool isSelected)
+    {
+        // a retake rewrites the same file, so a new modification time also means a new source
+        const auto modified = file.getLastModificationTime();
+
+        if (file != takeFile || modified != takeModified) {
+            takeFile = file;
+            takeModified = modified;
+            // looked up in the cache by path and file time; audio is only read if no thumbnail exists yet
+            thumbnail.setSource (file.existsAsFile() ? new juce::FileInputSource (file, true) : nullptr);
+        }
+        bSelected = isSelected;
+        repaint();
+    }
+
+    void paint (juce::Graphics& g) override
+    {
+        auto bounds = getLocalBounds().reduced (2);
+
+        g.setColour (bSelected ? browser.colourBackground.brighter (0.2f) : browser.colourBackground);
+        g.fillRect (bounds);
+
+        g.setColour (browser.colourWaveform);
+        g.setFont (12.0f);
+        g.drawText (takeFile.getFileNameWithoutExtension(), bounds.removeFromLeft (60).reduced (4, 0), juce::Justification::centredLeft, true);
+
+        if (thumbnail.getTotalLength() > 0.0)
+            thumbnail.drawChannels (g, bounds, 0.0, thumbnail.getTotalLength(), 1.0f);
+    }
+
+private:
+    void changeListenerCallback (juce::ChangeBroadcaster*) override
+    {
+        repaint();
+    }
+
+    TakeBrowser& browser;
+    juce::AudioThumbnail thumbnail;
+    juce::File takeFile;
+    juce::Time takeModified;
+    bool bSelected = false;
+};
+
+//==============================================================================
+TakeBrowser::TakeBrowser()
+{
+    formatManager.registerBasicFormats();
+
+    addAndMakeVisible (&listBox);
+    listBox.setModel (this);
+    listBox.setRowHeight (40);
+    listBox.setColour (juce::ListBox::backgroundColourId, juce::Colours::transparentBlack);
+}
+
+TakeBrowser::~TakeBrowser()
+{
+    listBox.setModel (nullptr);
+}
+
+void TakeBrowser::setDirectory (const juce::File& directory)
+{
+    takeDirectory = directory;
+    thumbnailCache.setCacheDirectory (directory.getChildFile (".thumbnails"));
+    refresh();
+}
+
+void TakeBrowser::refresh()
+{
+    takes.clearQuick();
+
+    if (takeDirectory.isDirectory())
+    {
+        takes = takeDirectory.findChildFiles (juce::File::findFiles, false, "*.wav");
+        juce::File::NaturalFileComparator comparator (false);
+        takes.sort (comparator);
+
+        // thumbnails are keyed on path and file time, so every retake leaves an
+        // old one behind; drop those that no longer match a take
+        juce::SortedSet<juce::int64> hashesInUse;
+        for (auto& take : takes)
+            hashesInUse.add (juce::FileInputSource (take, true).hashCode());
+        thumbnailCache.removeUnusedThumbs (hashesInUse);
+    }
+
+    listBox.updateContent();
+    listBox.repaint();
+}
+
+void TakeBrowser::setColours (juce::Colour background, juce::Colour waveform)
+{
+    colourBackground = background;
+    colourWaveform = waveform;
+    repaint();
+}
+
+//==============================================================================
+void TakeBrowser::paint (juce::Graphics& g)
+{
+    g.fillAll (colourBackground);
+}
+
+void TakeBrowser::resized()
+{
+    listBox.setBounds (getLocalBounds());
+}
+
+//==============================================================================
+int TakeBrowser::getNumRows()
+{
+    return takes.size();
+}
+
+void TakeBrowser::paintListBoxItem (int rowNumber, juce::Graphics& g, int width, int height, bool rowIsSelected)
+{
+    // rows are drawn by TakeRow
+}
+
+juce::Component* TakeBrowser::refreshComponentForRow (int rowNumber, bool isRowSelected, juce::Component* existingComponentToUpdate)
+{
+    auto* row = static_cast<TakeRow*> (existingComponentToUpdate);
+
+    if (rowNumber >= takes.size()) {
+        delete row;
+        return nullptr;
+    }
+
+    if (row == nullptr)
+        row = new TakeRow (*this);
+
+    row->update (takes[rowNumber], isRowSelected);
+    return row;
+}
+
+void TakeBrowser::listBoxItemDoubleClicked (int row, const juce::MouseEvent&)
+{
+    if (onTakeChosen != nullptr && juce::isPositiveAndBelow (row, takes.size()))
+        onTakeChosen (takes[row]);
+}
@@ -0,0 +1,63 @@
+/*
+  ==============================================================================
+
+    TakeBrowser.h
+    Created: 19 Oct 2026
+    Author:  Patrick Gammack
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "ThumbnailCache.h"
+
+//==============================================================================
+/**
+    Scrollable list of the recorded takes in the sample directory, each drawn
+    with its waveform thumbnail. Only the visible rows hold a thumbnail, and
+    those are served from a PersistentThumbnailCache.
+*/
+
+class TakeBrowser :
+public juce::Component,
+private juce::ListBoxModel
+{
+public:
+    TakeBrowser();
+    ~TakeBrowser() override;
+
+    void setDirectory (const juce::File& directory);
+    // rescans the directory; rows whose file changed since they were drawn reload their thumbnail
+    void refresh();
+    void setColours (juce::Colour background, juce::Colour waveform);
+
+    // called when a take is double-clicked
+    std::function<void(const juce::File&)> onTakeChosen;
+
+    //==============================================================================
+    void paint (juce::Graphics&) override;
+    void resized() override;
+
+private:
+    class TakeRow;
+
+    int getNumRows() override;
+    void paintListBoxItem (int rowNumber, juce::Graphics&, int width, int height, bool rowIsSelected) override;
+    juce::Component* refreshComponentForRow (int rowNumber, bool isRowSelected, juce::Component* existingComponentToUpdate) override;
+    void listBoxItemDoubleClicked (int row, const juce::MouseEvent&) override;
+
+    juce::AudioFormatManager formatManager;
+    PersistentThumbnailCache thumbnailCache { 256 };
+
+    juce::File takeDirectory;
+    juce::Array<juce::File> takes;
+
+    juce::ListBox listBox;
+
+    juce::Colour colourBackground;
+    juce::Colour colourWaveform;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (TakeBrowser)
+};
@@ -0,0 +1,139 @@
+/*
+  ==============================================================================
+
+    TakeIndex.cpp
+    Created: 19 Oct 2026
+    Author:  Patrick Gammack
+
+  ==============================================================================
+*/
+
+#include "TakeIndex.h"
+
+static const char indexMagic[4] = { 'S', 'A', 't', 'i' };
+static const int iSlotsPerChunk = 256;
+
+//==============================================================================
+TakeIndex::TakeIndex()
+{
+}
+
+TakeIndex::~TakeIndex()
+{
+    close();
+}
+
+bool TakeIndex::open (const juce::File& directory)
+{
+    close();
+    indexFile = directory.getChildFile ("takes.idx");
+
+    if (indexFile.existsAsFile() && map())
+    {
+        auto* header = getHeader();
+        if (std::memcmp (header->magic, indexMagic, 4) == 0
+         && header->iVersion == iVersion
+         && header->iRecordSize == (juce::int32) sizeof (TakeRecord)
+         && mappedFile->getSize() >= sizeof (Header) + (size_t) header->iNumSlots * sizeof (TakeRecord))
+            return true;
+
+        // unreadable or from another version; the analysis it held can be regenerated
+        mappedFile.reset();
+    }
+
+    return create (iSlotsPerChunk);
+}
+
+void TakeIndex::close()
+{
+    mappedFile.reset();
+}
+
+bool TakeIndex::isOpen() const
+{
+    return mappedFile != nullptr;
+}
+
+int TakeIndex::getNumSlots() const
+{
+    return isOpen() ? getHeader()->iNumSlots : 0;
+}
+
+TakeRecord* TakeIndex::getRecord (int slot)
+{
+    if (! isOpen() || slot < 0 || slot >= iMaxSlots)
+        return nullptr;
+
+    if (slot >= getNumSlots() && ! grow ((slot / iSlotsPerChunk + 1) * iSlotsPerChunk))
+        return nullptr;
+
+    auto* records = reinterpret_cast<TakeRecord*> (static_cast<char*> (mappedFile->getData()) + sizeof (Header));
+    return records + slot;
+}
+
+//==============================================================================
+bool TakeIndex::create (int numSlots)
+{
+    indexFile.deleteFile();
+
+    {
+        juce::FileOutputStream stream (indexFile);
+        if (stream.failedToOpen())
+            return false;
+
+        Header header;
+        std::memcpy (header.magic, indexMagic, 4);
+        header.iVersion = iVersion;
+        header.iRecordSize = (juce::int32) sizeof (TakeRecord);
+        header.iNumSlots = 0;
+        stream.write (&header, sizeof (Header));
+    }
+
+    return grow (numSlots);
+}
+
+bool TakeIndex::grow (int numSlots)
+{
+    const int iOldSlots = isOpen() ? getNumSlots() : 0;
+    mappedFile.reset();
+
+    {
+        juce::FileOutputStream stream (indexFile);
+        if (stream.failedToOpen())
+            return false;
+
+        // new records start zeroed, with their slot number filled in
+        stream.setPosition ((juce::int64) (sizeof (Header) + (size_t) iOldSlots * sizeof (TakeRecord)));
+        for (int i = iOldSlots; i < numSlots; i++) {
+            TakeRecord record {};
+            record.iSlot = i;
+            stream.write (&record, sizeof (TakeRecord));
+        }
+
+        stream.setPosition (0);
+        Header header;
+        std::memcpy (header.magic, indexMagic, 4);
+        header.iVersion = iVersion;
+        header.iRecordSize = (juce::int32) sizeof (TakeRecord);
+        header.iNumSlots = numSlots;
+        stream.write (&header, sizeof (Header));
+    }
+
+    return map();
+}
+
+bool TakeIndex::map()
+{
+    mappedFile = std::make_unique<juce::MemoryMappedFile> (indexFile, juce::MemoryMappedFile::readWrite);
+
+    if (mappedFile->getData() == nullptr || mappedFile->getSize() < sizeof (Header)) {
+        mappedFile.reset();
+        return false;
+    }
+    return true;
+}
+
+TakeIndex::Header* TakeIndex::getHeader() const
+{
+    return static_cast<Header*> (mappedFile->getData());
+}
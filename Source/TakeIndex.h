@@ -0,0 +1,83 @@
+/*
+  ==============================================================================
+
+    TakeIndex.h
+    Created: 19 Oct 2026
+    Author:  Patrick Gammack
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+//==============================================================================
+/**
+    Per-slot take data. Stored verbatim in the index file, so only append new
+    fields in place of iReserved and bump TakeIndex::iVersion when changing it.
+*/
+
+struct TakeRecord
+{
+    enum Flags {
+        RECORDED = 1 << 0,
+        OUT_OF_TOLERANCE = 1 << 1, // loudness missed its layer target
+    };
+
+    juce::int32 iSlot;
+    juce::int32 iFlags;
+    juce::int32 iNumTakes;      // how many times this slot has been recorded
+    juce::int32 iReserved;
+    juce::int64 iLengthSamples;
+    juce::int64 iRecordedTime;  // ms since epoch
+    double dSampleRate;
+    float fPeak;
+    float fLoudness;        // max momentary, LUFS
+};
+
+//==============================================================================
+/**
+    Table of TakeRecords kept in a memory-mapped file next to the samples, so
+    session state only needs to store the directory and opening a library of
+    any size costs the same.
+*/
+
+class TakeIndex
+{
+public:
+    TakeIndex();
+    ~TakeIndex();
+
+    bool open (const juce::File& directory);
+    void close();
+    bool isOpen() const;
+
+    int getNumSlots() const;
+
+    // grows the file if slot is past the end; nullptr if no index is open
+    // or slot is outside [0, iMaxSlots)
+    TakeRecord* getRecord (int slot);
+
+    static constexpr juce::int32 iVersion = 1;
+    static constexpr int iMaxSlots = 65536; // far beyond any library, and keeps the file a few MB
+
+private:
+    struct Header
+    {
+        char magic[4];
+        juce::int32 iVersion;
+        juce::int32 iRecordSize;
+        juce::int32 iNumSlots;
+    };
+
+    bool create (int numSlots);
+    bool grow (int numSlots);
+    bool map();
+    Header* getHeader() const;
+
+    juce::File indexFile;
+    std::unique_ptr<juce::MemoryMappedFile> mappedFile;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (TakeIndex)
+};
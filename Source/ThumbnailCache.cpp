@@ -0,0 +1,96 @@
+/*
+  ==============================================================================
+
+    ThumbnailCache.cpp
+    Created: 19 Oct 2026
+    Author:  Patrick Gammack
+
+  ==============================================================================
+*/
+
+#include "ThumbnailCache.h"
+
+//==============================================================================
+PersistentThumbnailCache::PersistentThumbnailCache (int maxThumbsInMemory)
+    : juce::AudioThumbnailCache (maxThumbsInMemory)
+{
+}
+
+PersistentThumbnailCache::~PersistentThumbnailCache()
+{
+}
+
+void PersistentThumbnailCache::setCacheDirectory (const juce::File& directory)
+{
+    directory.createDirectory();
+
+    const juce::ScopedLock sl (directoryLock);
+    cacheDirectory = directory;
+}
+
+void PersistentThumbnailCache::removeUnusedThumbs (const juce::SortedSet<juce::int64>& hashesInUse)
+{
+    juce::File directory;
+    {
+        const juce::ScopedLock sl (directoryLock);
+        directory = cacheDirectory;
+    }
+
+    if (! directory.isDirectory())
+        return;
+
+    for (auto& file : directory.findChildFiles (juce::File::findFiles, false, "*.thumb"))
+    {
+        const auto name = file.getFileNameWithoutExtension();
+        if (name.containsChar ('_'))
+            continue; // a TemporaryFile still being written
+
+        if (! hashesInUse.contains (name.getHexValue64()))
+            file.deleteFile();
+    }
+}
+
+juce::File PersistentThumbnailCache::getThumbFile (juce::int64 hashCode) const
+{
+    const juce::ScopedLock sl (directoryLock);
+
+    if (cacheDirectory == juce::File{})
+        return {};
+
+    return cacheDirectory.getChildFile (juce::String::toHexString (hashCode) + ".thumb");
+}
+
+// called on the cache's background thread once a thumbnail has been fully generated
+void PersistentThumbnailCache::saveNewlyFinishedThumbnail (const juce::AudioThumbnailBase& thumb, juce::int64 hashCode)
+{
+    auto file = getThumbFile (hashCode);
+    if (file == juce::File{})
+        return;
+
+    // write to a temporary file so a half-written thumbnail is never picked up
+    juce::TemporaryFile temp (file);
+
+    if (auto outputStream = std::unique_ptr<juce::FileOutputStream> (temp.getFile().createOutputStream()))
+    {
+        {
+            juce::GZIPCompressorOutputStream compressed (*outputStream);
+            thumb.saveTo (compressed);
+        }
+        outputStream.reset();
+        temp.overwriteTargetFileWithTemporary();
+    }
+}
+
+bool PersistentThumbnailCache::loadNewThumb (juce::AudioThumbnailBase& thumb, juce::int64 hashCode)
+{
+    auto file = getThumbFile (hashCode);
+    if (! file.existsAsFile())
+        return false;
+
+    juce::FileInputStream inputStream (file);
+    if (inputStream.failedToOpen())
+        return false;
+
+    juce::GZIPDecompressorInputStream decompressed (inputStream);
+    return thumb.loadFrom (decompressed);
+}
@@ -0,0 +1,44 @@
+/*
+  ==============================================================================
+
+    ThumbnailCache.h
+    Created: 19 Oct 2026
+    Author:  Patrick Gammack
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+//==============================================================================
+/**
+    AudioThumbnailCache that keeps every finished thumbnail on disk, so a take
+    is only ever scanned once. Thumbnails are stored gzipped, one file per
+    source hash, in the given cache directory.
+*/
+
+class PersistentThumbnailCache : public juce::AudioThumbnailCache
+{
+public:
+    PersistentThumbnailCache (int maxThumbsInMemory);
+    ~PersistentThumbnailCache() override;
+
+    void setCacheDirectory (const juce::File& directory);
+
+    // deletes stored thumbnails for any source hash not in hashesInUse
+    void removeUnusedThumbs (const juce::SortedSet<juce::int64>& hashesInUse);
+
+protected:
+    void saveNewlyFinishedThumbnail (const juce::AudioThumbnailBase& thumb, juce::int64 hashCode) override;
+    bool loadNewThumb (juce::AudioThumbnailBase& thumb, juce::int64 hashCode) override;
+
+private:
+    juce::File getThumbFile (juce::int64 hashCode) const;
+
+    juce::CriticalSection directoryLock;
+    juce::File cacheDirectory;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (PersistentThumbnailCache)
+};